@@ -7,55 +7,8 @@
 #include <filesystem>
 
 // Static member definitions
-LogLevel Logger::currentLogLevel = LogLevel::INFO;
 std::map<std::string, std::vector<int64_t>> PerformanceProfiler::timings_;
 
-// Logger Implementation
-void Logger::Log(LogLevel level, const std::string& category, const std::string& message) {
-    if (level < currentLogLevel) return;
-    
-    std::string prefix = GetLogPrefix(level);
-    std::string timestamp = GetTimestamp();
-    std::string fullMessage = "[" + timestamp + "] " + prefix + " [" + category + "] " + message;
-    
-    if (_globalCvarManager) {
-        _globalCvarManager->log(fullMessage);
-    }
-    
-    WriteToLogFile(fullMessage);
-}
-
-std::string Logger::GetLogPrefix(LogLevel level) {
-    switch (level) {
-        case LogLevel::DEBUG: return "[DEBUG]";
-        case LogLevel::INFO: return "[INFO]";
-        case LogLevel::WARNING: return "[WARNING]";
-        case LogLevel::ERROR: return "[ERROR]";
-        default: return "[UNKNOWN]";
-    }
-}
-
-std::string Logger::GetTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%H:%M:%S");
-    return ss.str();
-}
-
-void Logger::WriteToLogFile(const std::string& message) {
-    try {
-        std::filesystem::create_directories("data");
-        std::ofstream logFile("data/boostmaster.log", std::ios::app);
-        if (logFile.is_open()) {
-            logFile << message << std::endl;
-        }
-    }
-    catch (...) {
-        // Fail silently to avoid infinite logging loops
-    }
-}
-
 // PerformanceProfiler Implementation
 PerformanceProfiler::ScopedTimer::ScopedTimer(const std::string& name) 
     : name_(name), start_(std::chrono::high_resolution_clock::now()) {}
@@ -178,105 +131,3 @@ void NotificationManager::RenderNotifications(CanvasWrapper canvas) {
 void NotificationManager::ClearAll() {
     activeNotifications.clear();
 }
-
-// HeatmapGenerator Implementation
-void HeatmapGenerator::RecordPosition(Vector pos, float intensity) {
-    float currentTime = std::chrono::duration<float>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
-    
-    heatmapData.push_back({pos, intensity, currentTime});
-    
-    int gridX, gridY;
-    WorldToGrid(pos, gridX, gridY);
-    
-    if (gridX >= 0 && gridX < GRID_SIZE && gridY >= 0 && gridY < GRID_SIZE) {
-        positionGrid[gridX][gridY] += intensity;
-    }
-    
-    // Limit data size to prevent memory bloat
-    if (heatmapData.size() > 50000) {
-        heatmapData.erase(heatmapData.begin(), heatmapData.begin() + 10000);
-    }
-}
-
-void HeatmapGenerator::RecordBoostUsage(Vector pos, float boostUsed) {
-    float currentTime = std::chrono::duration<float>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
-    
-    boostUsageData.push_back({pos, boostUsed, currentTime});
-    
-    int gridX, gridY;
-    WorldToGrid(pos, gridX, gridY);
-    
-    if (gridX >= 0 && gridX < GRID_SIZE && gridY >= 0 && gridY < GRID_SIZE) {
-        boostGrid[gridX][gridY] += boostUsed;
-    }
-    
-    if (boostUsageData.size() > 20000) {
-        boostUsageData.erase(boostUsageData.begin(), boostUsageData.begin() + 5000);
-    }
-}
-
-void HeatmapGenerator::WorldToGrid(Vector worldPos, int& gridX, int& gridY) {
-    // Rocket League field dimensions: X: -4096 to 4096, Y: -5120 to 5120
-    gridX = (int)((worldPos.X + 4096.0f) / 8192.0f * GRID_SIZE);
-    gridY = (int)((worldPos.Y + 5120.0f) / 10240.0f * GRID_SIZE);
-}
-
-void HeatmapGenerator::GeneratePositionHeatmap() {
-    Logger::Log(LogLevel::INFO, "Heatmap", "Generating position heatmap with " + 
-               std::to_string(heatmapData.size()) + " data points");
-    // Implementation for generating visual heatmap
-}
-
-void HeatmapGenerator::GenerateBoostUsageHeatmap() {
-    Logger::Log(LogLevel::INFO, "Heatmap", "Generating boost usage heatmap with " + 
-               std::to_string(boostUsageData.size()) + " data points");
-    // Implementation for generating boost usage heatmap
-}
-
-void HeatmapGenerator::ExportHeatmap(const std::string& filename) {
-    try {
-        std::filesystem::create_directories("data/heatmaps");
-        std::ofstream file("data/heatmaps/" + filename + ".csv");
-        
-        // Export position grid
-        file << "Position Heatmap\n";
-        for (int y = 0; y < GRID_SIZE; ++y) {
-            for (int x = 0; x < GRID_SIZE; ++x) {
-                file << positionGrid[x][y];
-                if (x < GRID_SIZE - 1) file << ",";
-            }
-            file << "\n";
-        }
-        
-        file << "\nBoost Usage Heatmap\n";
-        for (int y = 0; y < GRID_SIZE; ++y) {
-            for (int x = 0; x < GRID_SIZE; ++x) {
-                file << boostGrid[x][y];
-                if (x < GRID_SIZE - 1) file << ",";
-            }
-            file << "\n";
-        }
-        
-        Logger::Log(LogLevel::INFO, "Heatmap", "Exported heatmap to " + filename + ".csv");
-    }
-    catch (const std::exception& e) {
-        Logger::Log(LogLevel::ERROR, "Heatmap", "Failed to export heatmap: " + std::string(e.what()));
-    }
-}
-
-void HeatmapGenerator::ClearData() {
-    heatmapData.clear();
-    boostUsageData.clear();
-    
-    // Clear grids
-    for (int x = 0; x < GRID_SIZE; ++x) {
-        for (int y = 0; y < GRID_SIZE; ++y) {
-            positionGrid[x][y] = 0.0f;
-            boostGrid[x][y] = 0.0f;
-        }
-    }
-    
-    Logger::Log(LogLevel::INFO, "Heatmap", "Cleared all heatmap data");
-}
\ No newline at end of file
@@ -0,0 +1,182 @@
+#include "pch.h"
+#include "AnalyticsWorker.h"
+#include "Logger.h"
+#include <chrono>
+
+AnalyticsWorker::AnalyticsWorker(SessionAnalytics& session, SessionRecorder& sessionRecorder)
+    : analytics(session), recorder(sessionRecorder) {
+    coachingStage = scheduler.AddStage("coaching", 10.0f, [this](float) {
+        analytics.CheckCoachingTriggers(view, lowBoostThreshold.load(std::memory_order_relaxed),
+                                        boostEfficiency.load(std::memory_order_relaxed));
+    });
+    playstyleStage = scheduler.AddStage("playstyle", 1.0f, [this](float) {
+        analytics.AnalyzePlaystyle(boostEfficiency.load(std::memory_order_relaxed));
+    });
+}
+
+AnalyticsWorker::~AnalyticsWorker() {
+    Stop();
+}
+
+void AnalyticsWorker::Start(float coachingRate, float playstyleRate) {
+    if (IsRunning()) return;
+    scheduler.SetStageRate(coachingStage, coachingRate);
+    scheduler.SetStageRate(playstyleStage, playstyleRate);
+    scheduler.Reset();
+
+    analytics.SetPads(&padSoA, &padTracker);
+    analytics.SetNotifySink([this](const Notification& notif) {
+        if (!notifications.TryPush(notif)) notificationsDropped.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    running.store(true, std::memory_order_release);
+    thread = std::thread(&AnalyticsWorker::Run, this);
+    Logger::Log(LogLevel::INFO, "Worker", "Analytics worker started");
+}
+
+void AnalyticsWorker::Stop() {
+    if (!IsRunning()) return;
+    running.store(false, std::memory_order_release);
+    thread.join();
+
+    analytics.SetNotifySink(nullptr);
+    analytics.SetPads(nullptr, nullptr);
+    Logger::Log(LogLevel::INFO, "Worker", "Analytics worker stopped after " + std::to_string(processed.load()) +
+               " records, " + std::to_string(dropped) + " dropped");
+}
+
+void AnalyticsWorker::Run() {
+    // Records arrive at the sample rate (at most every ~8 ms), so a short sleep when
+    // idle keeps latency low without the producer having to signal anything
+    while (running.load(std::memory_order_acquire)) {
+        if (!Drain()) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    Drain();
+}
+
+bool AnalyticsWorker::Drain() {
+    TelemetryRecord record;
+    uint64_t count = 0;
+    while (records.TryPop(record)) {
+        Process(record);
+        ++count;
+    }
+    if (count) processed.fetch_add(count, std::memory_order_relaxed);
+
+    std::vector<std::function<void()>> pending;
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        pending.swap(jobs);
+    }
+    for (auto& job : pending) {
+        try {
+            job();
+        }
+        catch (const std::exception& ex) {
+            Logger::Log(LogLevel::ERROR, "Worker", "Job failed: " + std::string(ex.what()));
+        }
+    }
+    return count > 0 || !pending.empty();
+}
+
+void AnalyticsWorker::Process(const TelemetryRecord& record) {
+    if (record.kind == TelemetryRecord::Kind::Event) {
+        recorder.AddEvent(record.event, record.time, record.arg, record.flags);
+        analytics.ApplyEvent(record.event, record.time, record.arg, padTracker);
+        return;
+    }
+
+    view.SetFrame(record.car, record.time);
+    const TelemetryFrame* frame = analytics.Sample(view);
+    if (frame) {
+        if (recorder.IsOpen()) recorder.Append(*frame);
+        timeline.Append(frame->time, frame->speed, frame->boost, boostEfficiency.load(std::memory_order_relaxed));
+    }
+    scheduler.Advance(record.time);
+}
+
+bool AnalyticsWorker::Push(const TelemetryRecord& record) {
+    if (!records.TryPush(record)) {
+        ++dropped;
+        return false;
+    }
+    ++pushed;
+    highWater = std::max(highWater, records.Size());
+    return true;
+}
+
+bool AnalyticsWorker::PushSample(float time, const CarSnapshot& car) {
+    TelemetryRecord record;
+    record.kind = TelemetryRecord::Kind::Sample;
+    record.time = time;
+    record.car = car;
+    return Push(record);
+}
+
+bool AnalyticsWorker::PushEvent(RecordedEventType type, float time, int32_t arg, uint32_t flags) {
+    TelemetryRecord record;
+    record.kind = TelemetryRecord::Kind::Event;
+    record.event = type;
+    record.arg = arg;
+    record.flags = flags;
+    record.time = time;
+    return Push(record);
+}
+
+bool AnalyticsWorker::PopNotification(Notification& out) {
+    return notifications.TryPop(out);
+}
+
+void AnalyticsWorker::SetCoachingInputs(float lowBoost, float efficiency) {
+    lowBoostThreshold.store(lowBoost, std::memory_order_relaxed);
+    boostEfficiency.store(efficiency, std::memory_order_relaxed);
+}
+
+void AnalyticsWorker::SetRates(float coachingRate, float playstyleRate) {
+    Post([this, coachingRate, playstyleRate] {
+        scheduler.SetStageRate(coachingStage, coachingRate);
+        scheduler.SetStageRate(playstyleStage, playstyleRate);
+    });
+}
+
+void AnalyticsWorker::SetPadLayout(const std::vector<StaticBoostPad>& pads) {
+    if (postedPads == &pads) return;
+    postedPads = &pads;
+    // Pad tables are static per map, so the worker can build from the same storage
+    Post([this, layout = &pads] {
+        padSoA.Build(*layout);
+        padTracker.Sync(*layout);
+    });
+}
+
+void AnalyticsWorker::Post(std::function<void()> job) {
+    if (!IsRunning()) {
+        job();
+        return;
+    }
+    std::lock_guard<std::mutex> lock(jobMutex);
+    jobs.push_back(std::move(job));
+}
+
+AnalyticsWorkerStats AnalyticsWorker::Stats() const {
+    AnalyticsWorkerStats stats;
+    stats.pushed = pushed;
+    stats.dropped = dropped;
+    stats.processed = processed.load(std::memory_order_relaxed);
+    stats.notificationsDropped = notificationsDropped.load(std::memory_order_relaxed);
+    stats.queued = records.Size();
+    stats.highWater = highWater;
+    return stats;
+}
+
+void AnalyticsWorker::ClearTimeline() {
+    Post([this] { timeline.Clear(); });
+}
+
+void AnalyticsWorker::ResetStats() {
+    pushed = 0;
+    dropped = 0;
+    highWater = 0;
+    processed.store(0, std::memory_order_relaxed);
+    notificationsDropped.store(0, std::memory_order_relaxed);
+}
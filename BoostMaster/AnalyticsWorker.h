@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SpscQueue.h"
+#include "SessionAnalytics.h"
+#include "SessionRecording.h"
+#include "SessionReplay.h"
+#include "TelemetryScheduler.h"
+#include "TimeSeriesPyramid.h"
+
+// One record handed from the game thread to the analytics worker. Samples carry
+// the car snapshot taken in the tick hook; events carry their type, argument (the
+// pad index for pickups) and Bmrec::kEvent* flags.
+struct TelemetryRecord {
+    enum class Kind : uint8_t { Sample, Event };
+
+    Kind kind = Kind::Sample;
+    RecordedEventType event = RecordedEventType::BallTouch;
+    int32_t arg = -1;
+    uint32_t flags = 0;
+    float time = 0.0f;
+    CarSnapshot car;
+};
+
+struct AnalyticsWorkerStats {
+    uint64_t pushed = 0;
+    uint64_t dropped = 0;              // records lost because the ring was full
+    uint64_t processed = 0;
+    uint64_t notificationsDropped = 0; // notifications lost because the game thread fell behind
+    size_t queued = 0;
+    size_t highWater = 0;
+};
+
+// Runs SessionAnalytics and the session recorder on a dedicated thread. The game
+// thread's only per-tick cost is one bounded, lock-free TryPush of a
+// TelemetryRecord; when the ring is full the record is dropped and counted, never
+// waited on. The worker drains the ring, samples, writes the recording, and runs
+// coaching and playstyle from its own TelemetryScheduler clocked by sample time.
+// Coaching notifications come back through a second ring drained by the game
+// thread. Anything else that touches the analytics or recorder (reports, saving,
+// heatmap export) must go through Post() while the worker is running.
+class AnalyticsWorker {
+public:
+    static constexpr size_t kQueueCapacity = 1024;       // about 8.5 seconds at 120 Hz
+    static constexpr size_t kNotificationCapacity = 64;
+
+    AnalyticsWorker(SessionAnalytics& analytics, SessionRecorder& recorder);
+    ~AnalyticsWorker();
+
+    void Start(float coachingRate, float playstyleRate);
+    // Joins the thread after it has drained every queued record and job
+    void Stop();
+    bool IsRunning() const { return thread.joinable(); }
+
+    // Game thread (single producer)
+    bool PushSample(float time, const CarSnapshot& car);
+    bool PushEvent(RecordedEventType type, float time, int32_t arg = -1, uint32_t flags = 0);
+    bool PopNotification(Notification& out);
+    void SetCoachingInputs(float lowBoostThreshold, float boostEfficiency);
+    void SetRates(float coachingRate, float playstyleRate);
+    // Rebuilds the worker's pad copy when the map's layout changes
+    void SetPadLayout(const std::vector<StaticBoostPad>& pads);
+
+    // Run job on the worker after the records queued so far; runs inline when stopped
+    void Post(std::function<void()> job);
+
+    // Speed, boost and efficiency since the last ClearTimeline(); safe to query from the UI
+    const SessionTimeline& Timeline() const { return timeline; }
+    // Start the timeline over once the records queued so far are processed
+    void ClearTimeline();
+
+    AnalyticsWorkerStats Stats() const;
+    void ResetStats();
+
+private:
+    void Run();
+    bool Drain();
+    void Process(const TelemetryRecord& record);
+    bool Push(const TelemetryRecord& record);
+
+    SessionAnalytics& analytics;
+    SessionRecorder& recorder;
+
+    SpscQueue<TelemetryRecord, kQueueCapacity> records;
+    SpscQueue<Notification, kNotificationCapacity> notifications;
+
+    std::mutex jobMutex;
+    std::vector<std::function<void()>> jobs;
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+    // Producer-owned counters
+    uint64_t pushed = 0;
+    uint64_t dropped = 0;
+    size_t highWater = 0;
+    const std::vector<StaticBoostPad>* postedPads = nullptr;
+    // Consumer-owned counters, read by Stats()
+    std::atomic<uint64_t> processed{0};
+    std::atomic<uint64_t> notificationsDropped{0};
+
+    std::atomic<float> lowBoostThreshold{20.0f};
+    std::atomic<float> boostEfficiency{0.0f};
+
+    // Worker-owned
+    ReplayGameView view;
+    TelemetryScheduler scheduler;
+    int coachingStage = -1;
+    int playstyleStage = -1;
+    BoostPadSoA padSoA;
+    BoostPadTracker padTracker;
+    SessionTimeline timeline;
+};
@@ -6,9 +6,12 @@
 #include <vector>
 #include <algorithm>
 
-void DrawHistogram(const std::vector<float>& data, const char* label) {
-    if (!data.empty()) {
-        ImGui::PlotHistogram(label, data.data(), (int)data.size(), 0, nullptr, 0.0f, *std::max_element(data.begin(), data.end()), ImVec2(0, 60));
+void DrawHistogram(const PlotSeries& series, const char* label) {
+    if (!series.Empty()) {
+        // One bar per pixel at most; the cached view only changes when data is appended
+        size_t width = (size_t)std::max(1.0f, ImGui::GetContentRegionAvail().x);
+        std::span<const float> data = series.Downsampled(width);
+        ImGui::PlotHistogram(label, data.data(), (int)data.size(), 0, nullptr, 0.0f, series.Max(), ImVec2(0, 60));
     } else {
         ImGui::Text("No data available");
     }
@@ -20,13 +23,20 @@ void BoostHUDWindow::Render() {
         BoostPadHelper::DrawPathOverlay(plugin);
     }
     ImGui::Begin("Boost Stats");
-    ImGui::Text("Total Used: %.1f", plugin->totalBoostUsed);
-    ImGui::Text("Avg Boost/Min: %.1f", plugin->avgBoostPerMinute);
-    ImGui::Text("Big Pads: %d  Small Pads: %d", plugin->bigPads, plugin->smallPads);
+    const BoostLedgerSnapshot ledger = plugin->LedgerSnapshot();
+    const BoostWindow& session = ledger.session;
+    ImGui::Text("Total Used: %.1f  Collected: %.1f", session.used, session.gained);
+    ImGui::Text("Avg Boost/Min: %.1f", session.PerMinute());
+    ImGui::Text("Big Pads: %d  Small Pads: %d", ledger.bigPads, ledger.smallPads);
+    ImGui::Text("Efficiency: %.0f%% session, %.0f%% last min, %.0f%% last 10s", session.Efficiency(),
+                ledger.lastMinute.Efficiency(), ledger.lastTenSeconds.Efficiency());
     ImGui::Separator();
     ImGui::Text("Efficiency Log (last session):");
     DrawHistogram(plugin->efficiencyLog, "Efficiency");
     ImGui::Text("History Log (all sessions):");
     DrawHistogram(plugin->historyLog, "History");
+    if (plugin->worker && ImGui::CollapsingHeader("Session Timeline")) {
+        timelinePlot.Render(plugin->worker->Timeline(), "Session");
+    }
     ImGui::End();
 }
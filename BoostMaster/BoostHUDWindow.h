@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GuiBase.h"
+#include "TimelinePlot.h"
 
 // Forward declaration
 class BoostMaster;
@@ -12,4 +13,5 @@ public:
 
 private:
     BoostMaster* plugin;
+    TimelinePlot timelinePlot;
 };
@@ -0,0 +1,117 @@
+#include "pch.h"
+#include "BoostLedger.h"
+#include <algorithm>
+
+void BoostLedger::Tick(float time, float boost, bool supersonic) {
+    // A gain that found no note within the window is final
+    if (unattributedGain > 0.0f && time - unattributedTime > kAttributionWindow) {
+        Credit(BoostSource::Other, unattributedGain);
+        unattributedGain = 0.0f;
+    }
+
+    if (hasLast && time > lastTime) {
+        float dt = time - lastTime;
+        float delta = boost - lastBoost;
+        // A respawn resets boost; a drop at that moment is not usage
+        bool respawned = respawnTime >= lastTime - kAttributionWindow;
+
+        if (dt > kMaxTickGap) {
+            // Dead, replaying a goal or paused: only account for what the reset gave back
+            if (delta > 0.0f) Credit(respawned ? BoostSource::Respawn : BoostSource::Other, delta);
+        }
+        else {
+            tracked += dt;
+            if (delta < 0.0f && !respawned) {
+                used -= delta;
+                if (!supersonic) usefulUsed -= delta;
+                boosting += dt;
+            }
+            else if (delta > 0.0f) {
+                if (time - pendingNoteTime <= kAttributionWindow) {
+                    Credit(pendingSource, delta);
+                    pendingNoteTime = -1e9f;
+                }
+                else {
+                    unattributedGain += delta;
+                    unattributedTime = time;
+                }
+            }
+        }
+    }
+
+    hasLast = true;
+    lastTime = time;
+    lastBoost = boost;
+    history.Push({time, tracked, used, usefulUsed, gained});
+}
+
+void BoostLedger::NotePickup(BoostSource source, float time) {
+    if (unattributedGain > 0.0f && time - unattributedTime <= kAttributionWindow) {
+        Credit(source, unattributedGain);
+        unattributedGain = 0.0f;
+        return;
+    }
+    pendingSource = source;
+    pendingNoteTime = time;
+}
+
+void BoostLedger::NoteRespawn(float time) {
+    respawnTime = time;
+    NotePickup(BoostSource::Respawn, time);
+}
+
+void BoostLedger::Credit(BoostSource source, float amount) {
+    gained += amount;
+    gainedBy[static_cast<size_t>(source)] += amount;
+    pickups[static_cast<size_t>(source)]++;
+}
+
+void BoostLedger::Reset() {
+    *this = BoostLedger{};
+}
+
+BoostWindow BoostLedger::Session() const {
+    BoostWindow window;
+    window.seconds = (float)tracked;
+    window.used = (float)used;
+    window.usefulUsed = (float)usefulUsed;
+    window.gained = (float)gained;
+    return window;
+}
+
+BoostWindow BoostLedger::Window(float seconds) const {
+    BoostWindow window;
+    if (history.Size() < 2) return window;
+
+    // Running totals are monotonic in time, so the window start is one bisection away
+    auto entries = history.View();
+    const Entry& last = entries.back();
+    auto it = std::lower_bound(entries.begin(), entries.end(), last.time - seconds,
+        [](const Entry& entry, float t) { return entry.time < t; });
+    const Entry& first = it == entries.end() ? last : *it;
+
+    window.seconds = (float)(last.tracked - first.tracked);
+    window.used = (float)(last.used - first.used);
+    window.usefulUsed = (float)(last.usefulUsed - first.usefulUsed);
+    window.gained = (float)(last.gained - first.gained);
+    return window;
+}
+
+BoostLedgerSnapshot BoostLedger::Snapshot() const {
+    BoostLedgerSnapshot snapshot;
+    snapshot.session = Session();
+    snapshot.lastMinute = Window(60.0f);
+    snapshot.lastTenSeconds = Window(10.0f);
+    snapshot.bigPads = Pickups(BoostSource::BigPad);
+    snapshot.smallPads = Pickups(BoostSource::SmallPad);
+    return snapshot;
+}
+
+BoostWindow BoostLedger::Since(const BoostLedgerMark& mark) const {
+    BoostWindow window;
+    window.seconds = (float)(tracked - mark.tracked);
+    window.used = (float)(used - mark.used);
+    window.usefulUsed = (float)(usefulUsed - mark.usefulUsed);
+    window.gained = (float)(gained - mark.gained);
+    return window;
+}
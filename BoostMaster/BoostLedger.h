@@ -0,0 +1,112 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "RingBuffer.h"
+
+// Where a boost increase came from
+enum class BoostSource : uint8_t {
+    BigPad,
+    SmallPad,
+    Respawn, // kickoff or demolition reset
+    Other,   // no pickup or reset seen near the gain (freeplay refills, etc.)
+    Count
+};
+
+// Boost spent and gained over a span of play
+struct BoostWindow {
+    float seconds = 0.0f;
+    float used = 0.0f;
+    float usefulUsed = 0.0f; // spent while not already supersonic
+    float gained = 0.0f;
+
+    // Share of boost spent while it could still add speed, 0-100
+    float Efficiency() const { return used > 0.0f ? 100.0f * usefulUsed / used : 0.0f; }
+    float PerMinute() const { return seconds > 0.0f ? used * 60.0f / seconds : 0.0f; }
+};
+
+// Session totals at one moment; Since() turns two of them into a window, e.g. a match
+struct BoostLedgerMark {
+    double tracked = 0.0;
+    double used = 0.0;
+    double usefulUsed = 0.0;
+    double gained = 0.0;
+};
+
+// The figures the HUD shows, copied out of the ledger on the game thread so the
+// render thread never reads the ledger while it is being ticked
+struct BoostLedgerSnapshot {
+    BoostWindow session;
+    BoostWindow lastMinute;
+    BoostWindow lastTenSeconds;
+    int bigPads = 0;
+    int smallPads = 0;
+};
+
+// Integrates the local car's boost tick by tick. Decreases are usage; increases are
+// matched to the nearest pickup or respawn noted within kAttributionWindow on either
+// side (hook order relative to the tick is not fixed). Every tick appends running
+// totals to a ring, so a window up to its span is the difference of two entries
+// found by one bisection; session totals are plain counters. Tick and the notes
+// are O(1).
+class BoostLedger {
+public:
+    static constexpr float kAttributionWindow = 0.15f;
+    // Ticks further apart than this (pauses, map loads) are not integrated
+    static constexpr float kMaxTickGap = 0.5f;
+    static constexpr size_t kHistoryCapacity = 120 * 120; // two minutes at 120 Hz
+
+    void Tick(float time, float boost, bool supersonic);
+    // A local pickup of a big or small pad
+    void NotePickup(BoostSource source, float time);
+    // Kickoff or demolition; boost is reset to the spawn amount
+    void NoteRespawn(float time);
+    void Reset();
+
+    float TotalUsed() const { return (float)used; }
+    float TotalGained() const { return (float)gained; }
+    float Gained(BoostSource source) const { return (float)gainedBy[static_cast<size_t>(source)]; }
+    int Pickups(BoostSource source) const { return pickups[static_cast<size_t>(source)]; }
+    // Play time covered by integrated ticks
+    float TrackedSeconds() const { return (float)tracked; }
+    // Time spent with boost going down
+    float BoostingSeconds() const { return (float)boosting; }
+
+    BoostWindow Session() const;
+    // The last `seconds` of ticks, or as much as the ring holds
+    BoostWindow Window(float seconds) const;
+    BoostLedgerSnapshot Snapshot() const;
+    BoostLedgerMark Mark() const { return { tracked, used, usefulUsed, gained }; }
+    // Everything integrated after mark was taken
+    BoostWindow Since(const BoostLedgerMark& mark) const;
+
+private:
+    struct Entry {
+        float time;
+        double tracked;
+        double used;
+        double usefulUsed;
+        double gained;
+    };
+
+    void Credit(BoostSource source, float amount);
+
+    RingBuffer<Entry> history{kHistoryCapacity};
+    bool hasLast = false;
+    float lastTime = 0.0f;
+    float lastBoost = 0.0f;
+
+    double tracked = 0.0;
+    double boosting = 0.0;
+    double used = 0.0;
+    double usefulUsed = 0.0;
+    double gained = 0.0;
+    double gainedBy[static_cast<size_t>(BoostSource::Count)] = {};
+    int pickups[static_cast<size_t>(BoostSource::Count)] = {};
+
+    // A note waiting for its gain, or a gain waiting for its note
+    BoostSource pendingSource = BoostSource::Other;
+    float pendingNoteTime = -1e9f;
+    float unattributedGain = 0.0f;
+    float unattributedTime = -1e9f;
+    float respawnTime = -1e9f;
+};
@@ -5,10 +5,12 @@
 #include "BoostPadGraph.h"
 #include "BoostHUDWindow.h"
 #include "BoostSettingsWindow.h"
+#include "SessionReplay.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <future>
 #include "thirdparty/json.hpp"
 #include "imgui/imgui.h"
 
@@ -18,25 +20,147 @@ int pathAlgo = 0; // 0 = Dijkstra, 1 = A*
 
 BAKKESMOD_PLUGIN(BoostMaster, "Boost usage tracker and trainer", "1.0", PLUGINTYPE_FREEPLAY)
 
-constexpr float TICK_INTERVAL = 1.0f / 120.0f;
+namespace {
+    // IGameView over the live game, for SessionAnalytics
+    class LiveGameView : public IGameView {
+    public:
+        LiveGameView(GameWrapper* gameWrapper, float now) : gw(gameWrapper), now(now) {}
+        
+        bool IsInGame() const override { return gw->IsInGame(); }
+        
+        bool GetLocalCar(CarSnapshot& out) const override {
+            CarWrapper car = gw->GetLocalCar();
+            if (car.IsNull()) return false;
+            out.location = car.GetLocation();
+            out.velocity = car.GetVelocity();
+            out.boost = BoostPercent(car.GetBoostComponent().GetCurrentBoostAmount());
+            out.onGround = car.IsOnGround();
+            out.supersonic = car.GetbSuperSonic();
+            return true;
+        }
+        
+        float Now() const override { return now; }
+        
+    private:
+        GameWrapper* gw;
+        float now;
+    };
+}
 
 void BoostMaster::saveMatch() {
     cvarManager->log("[BoostMaster] saveMatch invoked");
     std::filesystem::create_directories("data");
     std::ofstream out("data/boost_history.csv", std::ios::app);
-    out << totalBoostUsed << "," << (totalBoostTime / 60.0f) << "\n";
+    BoostWindow match = boostLedger.Since(matchStart);
+    out << match.used << "," << (match.seconds / 60.0f) << "\n";
+    matchStart = boostLedger.Mark();
+    worker->Post([this] { SaveLongTermSketches(); });
+    StopRecording();
     cvarManager->log("[BoostMaster] Match data saved");
 }
 
+// Heatmap image options shared by the image and timelapse commands; false if arg is
+// not one of them
+static bool ParseHeatmapImageArg(const std::string& arg, HeatmapLayer& layer, int& band,
+                                 HeatmapImageOptions& options, HeatmapImageFormat& format) {
+    if (arg == "position") layer = HeatmapLayer::Position;
+    else if (arg == "boost") layer = HeatmapLayer::BoostUsage;
+    else if (arg == "ground") band = static_cast<int>(HeightBand::Ground);
+    else if (arg == "lowair") band = static_cast<int>(HeightBand::LowAir);
+    else if (arg == "highair") band = static_cast<int>(HeightBand::HighAir);
+    else if (arg == "viridis") options.colormap = HeatmapColormap::Viridis;
+    else if (arg == "inferno") options.colormap = HeatmapColormap::Inferno;
+    else if (arg == "png") format = HeatmapImageFormat::Png;
+    else if (arg == "ppm") format = HeatmapImageFormat::Ppm;
+    else if (arg == "gif") format = HeatmapImageFormat::Gif;
+    else return false;
+    return true;
+}
+
+// Delete the oldest recordings in dir so that, with the one about to start, keep
+// remain; 0 keeps everything. Names carry their start time, so name order is age order.
+static void PruneRecordings(const std::string& dir, int keep) {
+    if (keep <= 0) return;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.path().extension() == ".bmrec") files.push_back(entry.path());
+    }
+    if (files.size() < (size_t)keep) return;
+    std::sort(files.begin(), files.end());
+    for (size_t i = 0; i + keep <= files.size(); ++i) {
+        std::error_code ec;
+        if (std::filesystem::remove(files[i], ec)) {
+            Logger::Log(LogLevel::INFO, "Recording", "Removed old recording " + files[i].string());
+        }
+    }
+}
+
+static json SketchToJson(const QuantileSketch& sketch) {
+    json j;
+    j["alpha"] = sketch.RelativeAccuracy();
+    j["min"] = sketch.MinValue();
+    j["max"] = sketch.MaxValue();
+    j["zero"] = sketch.ZeroCount();
+    j["buckets"] = sketch.Buckets();
+    return j;
+}
+
+static void MergeSketchFromJson(const json& j, QuantileSketch& into) {
+    QuantileSketch loaded(j["alpha"].get<double>(), j["min"].get<double>(), j["max"].get<double>());
+    if (loaded.Restore(j["zero"].get<uint64_t>(), j["buckets"].get<std::vector<uint64_t>>())) {
+        into.Merge(loaded);
+    }
+}
+
+bool BoostMaster::LoadLongTermSketches(SessionSketches& out) {
+    try {
+        std::ifstream file("data/boost_sketches.json");
+        if (!file.is_open()) return false;
+        json j;
+        file >> j;
+        MergeSketchFromJson(j["speed"], out.speed);
+        MergeSketchFromJson(j["boost"], out.boost);
+        MergeSketchFromJson(j["boostPerMinute"], out.boostPerMinute);
+        return true;
+    }
+    catch (const std::exception& ex) {
+        cvarManager->log("[BoostMaster] Error loading sketches: " + std::string(ex.what()));
+        return false;
+    }
+}
+
+// Merge this session's not-yet-saved distributions into the long-term sketches
+void BoostMaster::SaveLongTermSketches() {
+    try {
+        SessionSketches longTerm;
+        LoadLongTermSketches(longTerm);
+        longTerm.Merge(analytics.metrics.unsavedSketches);
+        
+        json j;
+        j["speed"] = SketchToJson(longTerm.speed);
+        j["boost"] = SketchToJson(longTerm.boost);
+        j["boostPerMinute"] = SketchToJson(longTerm.boostPerMinute);
+        
+        std::filesystem::create_directories("data");
+        std::ofstream file("data/boost_sketches.json");
+        file << j.dump();
+        analytics.metrics.unsavedSketches.Reset();
+    }
+    catch (const std::exception& ex) {
+        cvarManager->log("[BoostMaster] Error saving sketches: " + std::string(ex.what()));
+    }
+}
+
 void BoostMaster::ResetStats() {
     cvarManager->log("[BoostMaster] ResetStats invoked");
-    totalBoostUsed = 0;
-    totalBoostTime = 0;
-    lastBoostAmt = -1;
-    bigPads = 0;
-    smallPads = 0;
-    efficiencyLog.clear();
+    boostLedger.Reset();
+    matchStart = boostLedger.Mark();
+    PublishLedgerSnapshot();
+    efficiencyLog.Clear();
     lastPath.clear();
+    telemetryScheduler.ResetStats();
+    worker->ResetStats();
+    worker->ClearTimeline();
     cvarManager->log("[BoostMaster] Stats reset");
 }
 
@@ -50,13 +174,21 @@ void BoostMaster::PrintPadPath() {
     auto ball = server.GetBall();
     if (ball.IsNull()) return;
 
-    const auto& pads = BoostPadHelper::GetCachedPads(this);
-    auto graph = BoostPadGraph::Build(pads);
-    int start = BoostPadGraph::Nearest(graph, car.GetLocation());
-    int goal = BoostPadGraph::Nearest(graph, ball.GetLocation());
+    const auto& graph = BoostPadHelper::GetCachedGraph(this);
+    const auto& index = BoostPadHelper::GetCachedSpatialIndex(this);
+    int start = index.Nearest(car.GetLocation());
+    int goal = index.Nearest(ball.GetLocation());
 
     cvarManager->log("Path start=" + std::to_string(start) + " goal=" + std::to_string(goal));
-    lastPath = BoostPadGraph::FindPath(graph, start, goal, pathAlgo == 1);
+    if (pathAlgo == 1) {
+        lastPath = BoostPadGraph::FindPath(graph, start, goal, true);
+    }
+    else {
+        // Shortest routes are precomputed per map; walking the table does not allocate
+        int route[kMaxBoostPads];
+        int len = BoostPadGraph::WalkRoute(BoostPadHelper::GetCachedRoutes(this), start, goal, route, kMaxBoostPads);
+        lastPath.assign(route, route + len);
+    }
 
     std::ostringstream oss;
     oss << "[BoostMaster] Path result:";
@@ -73,6 +205,11 @@ void BoostMaster::RegisterDrawables() {
         // Draw path overlay
         if (!lastPath.empty())
             BoostPadHelper::DrawPathOverlayCanvas(this, canvas, lastPath);
+
+        // Draw live coaching route
+        if (!coachRoute.Empty() && BoostSettingsWindow::ShouldShowCoachRoute())
+            BoostPadHelper::DrawPathOverlayCanvas(this, canvas, std::span<const int>(coachRoute.pads, coachRoute.count),
+                LinearColor{0.0f, 1.0f, 1.0f, 1.0f});
         
         // Draw advanced overlay
         RenderAdvancedOverlay(canvas);
@@ -91,6 +228,11 @@ void BoostMaster::onLoad() {
 
         // Initialize global cvar manager for logging
         _globalCvarManager = cvarManager;
+        Logger::SetSink([](const std::string& message) {
+            if (_globalCvarManager) {
+                _globalCvarManager->log(message);
+            }
+        });
         
         // Initialize advanced systems
         InitializeAdvancedSystems();
@@ -100,6 +242,69 @@ void BoostMaster::onLoad() {
         cvarManager->registerCvar("boostmaster_lowtime", std::to_string(cvarLowBoostTime), "seconds low before warning", true, true, 0.1f, true, 30.0f);
         cvarManager->registerCvar("boostmaster_maxtime", std::to_string(cvarMaxBoostTime), "seconds full before warning", true, true, 0.1f, true, 30.0f);
 
+        cvarManager->registerCvar("boostmaster_sample_rate", std::to_string(cvarSampleRate), "telemetry samples per second", true, true, 1.0f, true, 120.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarSampleRate = cvar.getFloatValue();
+                telemetryScheduler.SetStageRate(sampleStage, cvarSampleRate);
+                worker->Post([this, rate = cvarSampleRate] { analytics.SetSampleRate(rate); });
+            });
+        cvarManager->registerCvar("boostmaster_coaching_rate", std::to_string(cvarCoachingRate), "coaching checks per second", true, true, 1.0f, true, 60.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarCoachingRate = cvar.getFloatValue();
+                telemetryScheduler.SetStageRate(coachingStage, cvarCoachingRate);
+                worker->SetRates(cvarCoachingRate, cvarPlaystyleRate);
+            });
+        cvarManager->registerCvar("boostmaster_playstyle_rate", std::to_string(cvarPlaystyleRate), "playstyle analyses per second", true, true, 0.1f, true, 10.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarPlaystyleRate = cvar.getFloatValue();
+                worker->SetRates(cvarCoachingRate, cvarPlaystyleRate);
+            });
+
+        cvarManager->registerCvar("boostmaster_heatmap_halflife", std::to_string(cvarHeatmapHalfLife), "seconds for a heatmap sample's weight to halve in the decayed view", true, true, 10.0f, true, 3600.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarHeatmapHalfLife = cvar.getFloatValue();
+                worker->Post([this, halfLife = cvarHeatmapHalfLife] { analytics.heatmap.SetHalfLife(halfLife); });
+            });
+        cvarManager->registerCvar("boostmaster_heatmap_recent", std::to_string(cvarHeatmapRecentMinutes), "minutes covered by the recent heatmap view", true, true, 1.0f, true, (float)HeatmapGenerator::MAX_RECENT_MINUTES)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarHeatmapRecentMinutes = cvar.getIntValue();
+                worker->Post([this, minutes = cvarHeatmapRecentMinutes] { analytics.heatmap.SetRecentMinutes(minutes); });
+            });
+        cvarManager->registerCvar("boostmaster_heatmap_timelapse_minutes", std::to_string(cvarHeatmapTimelapseMinutes), "minutes of play a heatmap timelapse can cover", true, true, (float)HeatmapGenerator::MAX_RECENT_MINUTES, true, (float)HeatmapGenerator::MAX_RETAINED_MINUTES)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarHeatmapTimelapseMinutes = cvar.getIntValue();
+                worker->Post([this, minutes = cvarHeatmapTimelapseMinutes] { analytics.heatmap.SetRetainedMinutes(minutes); });
+            });
+        cvarManager->registerCvar("boostmaster_heatmap_cell", std::to_string(cvarHeatmapCellSize), "heatmap cell size in unreal units; changing it clears the heatmap", true, true, 25.0f, true, 400.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarHeatmapCellSize = cvar.getFloatValue();
+                worker->Post([this, cellSize = cvarHeatmapCellSize, bands = cvarHeatmapHeightBands] { analytics.heatmap.SetResolution(cellSize, bands); });
+            });
+        cvarManager->registerCvar("boostmaster_heatmap_bands", cvarHeatmapHeightBands ? "1" : "0", "split the heatmap into ground, low air and high air; changing it clears the heatmap", true, true, 0.0f, true, 1.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarHeatmapHeightBands = cvar.getBoolValue();
+                worker->Post([this, cellSize = cvarHeatmapCellSize, bands = cvarHeatmapHeightBands] { analytics.heatmap.SetResolution(cellSize, bands); });
+            });
+        cvarManager->registerCvar("boostmaster_heatmap_image_width", std::to_string(cvarHeatmapImageWidth), "heatmap image width in pixels", true, true, 256.0f, true, 4096.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarHeatmapImageWidth = cvar.getIntValue();
+            });
+        cvarManager->registerCvar("boostmaster_heatmap_kernel", std::to_string(cvarHeatmapKernel), "heatmap kernel density bandwidth in unreal units, 0 for plain bins; changing it clears the heatmap", true, true, 0.0f, true, 1000.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarHeatmapKernel = cvar.getFloatValue();
+                worker->Post([this, bandwidth = cvarHeatmapKernel] { analytics.heatmap.SetKernelBandwidth(bandwidth); });
+            });
+
+        cvarManager->registerCvar("boostmaster_record", recordSessions ? "1" : "0", "record full-rate sessions to data/recordings", true, true, 0.0f, true, 1.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                recordSessions = cvar.getBoolValue();
+                if (!recordSessions) StopRecording();
+            });
+        cvarManager->registerCvar("boostmaster_record_keep", std::to_string(cvarRecordingKeep), "number of recordings kept in data/recordings, 0 for all", true, true, 0.0f, true, 1000.0f)
+            .addOnValueChanged([this](std::string, CVarWrapper cvar) {
+                cvarRecordingKeep = cvar.getIntValue();
+            });
+
         // Reset stats
         cvarManager->registerNotifier("boostmaster_reset", [this](const std::vector<std::string>&) {
             ResetStats();
@@ -139,22 +344,95 @@ void BoostMaster::onLoad() {
             }, "Analyze current playstyle", PERMISSION_ALL);
             
         cvarManager->registerNotifier("boostmaster_clearheatmap", [this](const std::vector<std::string>&) {
-            if (heatmapGenerator) {
-                heatmapGenerator->ClearData();
+            worker->Post([this] {
+                analytics.heatmap.ClearData();
                 Logger::Log(LogLevel::INFO, "Commands", "Heatmap data cleared");
-            }
+            });
             }, "Clear heatmap data", PERMISSION_ALL);
             
         cvarManager->registerNotifier("boostmaster_exportheatmap", [this](const std::vector<std::string>& args) {
-            if (heatmapGenerator) {
-                std::string filename = args.empty() ? "session_heatmap" : args[0];
-                heatmapGenerator->ExportHeatmap(filename);
+            std::string filename = args.empty() ? "session_heatmap" : args[0];
+            HeatmapView view = HeatmapView::Cumulative;
+            if (args.size() > 1) {
+                if (args[1] == "decayed") view = HeatmapView::Decayed;
+                else if (args[1] == "recent") view = HeatmapView::Recent;
+                else if (args[1] != "all") {
+                    Logger::Log(LogLevel::WARNING, "Commands", "Unknown heatmap view '" + args[1] + "' (all, decayed, recent)");
+                    return;
+                }
             }
-            }, "Export heatmap data", PERMISSION_ALL);
+            worker->Post([this, filename, view] { analytics.heatmap.ExportHeatmap(filename, view); });
+            }, "Export heatmap data; optional view: all, decayed or recent", PERMISSION_ALL);
+            
+        cvarManager->registerNotifier("boostmaster_heatmapimage", [this](const std::vector<std::string>& args) {
+            std::string filename = args.empty() ? "session_heatmap" : args[0];
+            HeatmapLayer layer = HeatmapLayer::Position;
+            HeatmapView view = HeatmapView::Cumulative;
+            HeatmapImageFormat format = HeatmapImageFormat::Png;
+            int band = HeatmapGenerator::ALL_BANDS;
+            HeatmapImageOptions options;
+            options.width = cvarHeatmapImageWidth;
+            // Options may come in any order
+            for (size_t i = 1; i < args.size(); ++i) {
+                const std::string& arg = args[i];
+                if (arg == "all") view = HeatmapView::Cumulative;
+                else if (arg == "decayed") view = HeatmapView::Decayed;
+                else if (arg == "recent") view = HeatmapView::Recent;
+                else if (!ParseHeatmapImageArg(arg, layer, band, options, format)) {
+                    Logger::Log(LogLevel::WARNING, "Commands", "Unknown heatmap image option '" + arg + "'");
+                    return;
+                }
+            }
+            // Layouts are static tables, so the worker can hold on to the pointer
+            options.pads = &BoostPadHelper::GetCachedPads(this);
+            worker->Post([this, filename, layer, view, band, options, format] {
+                analytics.heatmap.ExportImage(filename, layer, view, band, options, format);
+            });
+            }, "Export a heatmap image; options: position|boost, all|decayed|recent, ground|lowair|highair, viridis|inferno, png|ppm", PERMISSION_ALL);
+            
+        cvarManager->registerNotifier("boostmaster_heatmaptimelapse", [this](const std::vector<std::string>& args) {
+            std::string filename = args.empty() ? "session_timelapse" : args[0];
+            HeatmapLayer layer = HeatmapLayer::Position;
+            int band = HeatmapGenerator::ALL_BANDS;
+            HeatmapTimelapseOptions timelapse;
+            HeatmapImageOptions options;
+            options.width = cvarHeatmapImageWidth;
+            // Numbers are the step then the window, in seconds; other options in any order
+            int numbers = 0;
+            for (size_t i = 1; i < args.size(); ++i) {
+                const std::string& arg = args[i];
+                char* end = nullptr;
+                float value = std::strtof(arg.c_str(), &end);
+                if (end != arg.c_str() && *end == '\0' && numbers < 2) {
+                    (numbers++ == 0 ? timelapse.stepSeconds : timelapse.windowSeconds) = value;
+                }
+                else if (!ParseHeatmapImageArg(arg, layer, band, options, timelapse.format)) {
+                    Logger::Log(LogLevel::WARNING, "Commands", "Unknown heatmap timelapse option '" + arg + "'");
+                    return;
+                }
+            }
+            options.pads = &BoostPadHelper::GetCachedPads(this);
+            worker->Post([this, filename, layer, band, timelapse, options] {
+                analytics.heatmap.ExportTimelapse(filename, layer, band, timelapse, options);
+            });
+            }, "Export an animated heatmap; [step] [window] seconds, then image options and gif|png|ppm", PERMISSION_ALL);
             
         cvarManager->registerNotifier("boostmaster_performance", [this](const std::vector<std::string>&) {
             PerformanceProfiler::PrintReport();
             }, "Show performance profiling report", PERMISSION_ALL);
+            
+        cvarManager->registerNotifier("boostmaster_inspectrec", [this](const std::vector<std::string>& args) {
+            if (args.empty()) return;
+            worker->Post([this, path = args[0]] { InspectRecording(path); });
+            }, "Summarize a .bmrec session recording", PERMISSION_ALL);
+            
+        cvarManager->registerNotifier("boostmaster_replay", [this](const std::vector<std::string>& args) {
+            ReplayRecordings(args.empty() ? "data/recordings" : args[0]);
+            }, "Re-run analytics over a recording or a folder of recordings", PERMISSION_ALL);
+            
+        cvarManager->registerNotifier("boostmaster_scheduler", [this](const std::vector<std::string>&) {
+            PrintSchedulerStats();
+            }, "Show telemetry scheduler and analytics worker stats", PERMISSION_ALL);
 
         // Help command
         cvarManager->registerNotifier("boostmaster_help", [this](const std::vector<std::string>&) {
@@ -164,8 +442,13 @@ void BoostMaster::onLoad() {
             Logger::Log(LogLevel::INFO, "Help", "  boostmaster_showpads - Toggle boost pad visualization");
             Logger::Log(LogLevel::INFO, "Help", "  boostmaster_report - Generate performance report");
             Logger::Log(LogLevel::INFO, "Help", "  boostmaster_playstyle - Analyze playstyle");
-            Logger::Log(LogLevel::INFO, "Help", "  boostmaster_exportheatmap <name> - Export heatmap");
+            Logger::Log(LogLevel::INFO, "Help", "  boostmaster_exportheatmap <name> [all|decayed|recent] - Export heatmap");
+            Logger::Log(LogLevel::INFO, "Help", "  boostmaster_heatmapimage <name> [options] - Export heatmap as PNG/PPM");
+            Logger::Log(LogLevel::INFO, "Help", "  boostmaster_heatmaptimelapse <name> [step] [window] [options] - Export animated heatmap of the last boostmaster_heatmap_timelapse_minutes (default " + std::to_string(HeatmapGenerator::DEFAULT_RETAINED_MINUTES) + ") of play");
             Logger::Log(LogLevel::INFO, "Help", "  boostmaster_performance - Show performance stats");
+            Logger::Log(LogLevel::INFO, "Help", "  boostmaster_scheduler - Show telemetry scheduler and worker stats");
+            Logger::Log(LogLevel::INFO, "Help", "  boostmaster_inspectrec <path> - Summarize a session recording");
+            Logger::Log(LogLevel::INFO, "Help", "  boostmaster_replay [path] - Re-run analytics over recordings");
             Logger::Log(LogLevel::INFO, "Help", "  boostmaster_config <option> <value> - Configure settings");
             }, "Show help message", PERMISSION_ALL);
 
@@ -194,6 +477,15 @@ void BoostMaster::onLoad() {
             saveMatch();
             });
 
+        // Level load hook; pad caches re-check the map name once per load
+        gameWrapper->HookEvent("Function TAGame.LoadingScreen_TA.HandlePostLoadMap", [this](const std::string&) {
+            BoostPadHelper::OnMapLoaded();
+            matchStart = boostLedger.Mark();
+            telemetryScheduler.Reset();
+            StopRecording();
+            worker->ClearTimeline();
+            });
+
         // Register advanced event hooks
         RegisterAdvancedHooks();
 
@@ -205,15 +497,8 @@ void BoostMaster::onLoad() {
         LoadAllTrainingDrills();
         loadHistory();
         
-        // Setup performance metrics update timer
-        gameWrapper->SetTimeout([this](GameWrapper* gw) {
-            UpdatePerformanceMetrics();
-            CheckCoachingTriggers();
-            if (notificationManager) {
-                notificationManager->Update(0.1f);
-            }
-            return false;
-        }, 0.1f);
+        // Sampling and analysis stages, advanced from the physics tick hook
+        RegisterTelemetryStages();
     }
     catch (const std::exception& ex) {
         cvarManager->log("[BoostMaster] Error in onLoad: " + std::string(ex.what()));
@@ -221,6 +506,7 @@ void BoostMaster::onLoad() {
 }
 
 void BoostMaster::onUnload() {
+    StopRecording();
     CleanupAdvancedSystems();
     UnregisterDrawables();
     Logger::Log(LogLevel::INFO, "Core", "BoostMaster unloaded");
@@ -427,7 +713,7 @@ void BoostMaster::loadHistory() {
             return;
         }
         
-        historyLog.clear();
+        historyLog.Clear();
         std::string line;
         while (std::getline(file, line)) {
             if (line.empty()) continue;
@@ -438,7 +724,7 @@ void BoostMaster::loadHistory() {
             if (std::getline(iss, boostUsed, ',') && std::getline(iss, playTime)) {
                 try {
                     float efficiency = std::stof(boostUsed) / std::max(0.1f, std::stof(playTime));
-                    historyLog.push_back(efficiency);
+                    historyLog.Push(efficiency);
                 }
                 catch (...) {
                     // Skip invalid lines
@@ -447,7 +733,7 @@ void BoostMaster::loadHistory() {
         }
         file.close();
         
-        cvarManager->log("[BoostMaster] Loaded " + std::to_string(historyLog.size()) + " history entries");
+        cvarManager->log("[BoostMaster] Loaded " + std::to_string(historyLog.Size()) + " history entries");
     }
     catch (const std::exception& ex) {
         cvarManager->log("[BoostMaster] Error loading history: " + std::string(ex.what()));
@@ -457,148 +743,114 @@ void BoostMaster::loadHistory() {
 // Advanced Systems Implementation
 void BoostMaster::InitializeAdvancedSystems() {
     notificationManager = std::make_unique<NotificationManager>();
-    heatmapGenerator = std::make_unique<HeatmapGenerator>();
-    currentSession.Reset();
+    analytics.Reset();
+    analytics.SetSampleRate(cvarSampleRate);
+    // Sampling, coaching, heatmaps and recording run off the game thread
+    worker = std::make_unique<AnalyticsWorker>(analytics, recorder);
+    worker->Start(cvarCoachingRate, cvarPlaystyleRate);
     lastUpdateTime = GetGameTime();
     
     Logger::Log(LogLevel::INFO, "Core", "Advanced systems initialized");
 }
 
 void BoostMaster::CleanupAdvancedSystems() {
+    // A replay batch stops after its current file
+    replayCancel.store(true);
+    if (replayThread.joinable()) replayThread.join();
+    // Drains what is still queued, including a pending recording close
+    if (worker) {
+        worker->Stop();
+    }
     if (notificationManager) {
         notificationManager.reset();
     }
-    if (heatmapGenerator) {
-        heatmapGenerator.reset();
-    }
     
     Logger::Log(LogLevel::INFO, "Core", "Advanced systems cleaned up");
 }
 
 float BoostMaster::GetGameTime() const {
-    return std::chrono::duration<float>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    // Relative to plugin load; a float of the raw epoch count is too coarse for 120 Hz samples
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
 }
 
 void BoostMaster::UpdatePerformanceMetrics() {
     PerformanceProfiler::ScopedTimer timer("UpdatePerformanceMetrics");
     
-    if (!gameWrapper->IsInGame()) return;
+    // Only the snapshot is taken here; the worker samples, bins and records it
+    LiveGameView game(gameWrapper.get(), GetGameTime());
+    CarSnapshot car;
+    if (!game.IsInGame() || !game.GetLocalCar(car)) return;
     
-    auto car = gameWrapper->GetLocalCar();
-    if (car.IsNull()) return;
-    
-    float currentTime = GetGameTime();
-    if (currentSession.sessionStartTime == 0.0f) {
-        currentSession.sessionStartTime = currentTime;
-    }
-    
-    // Track speed and position
-    Vector velocity = car.GetVelocity();
-    Vector position = car.GetLocation();
-    float speed = velocity.magnitude();
-    
-    currentSession.speedHistory.push_back(speed);
-    currentSession.positionHistory.push_back(position);
-    
-    // Record heatmap data
-    if (heatmapGenerator) {
-        heatmapGenerator->RecordPosition(position, 1.0f);
-        
-        // Track boost usage
-        float boostAmount = car.GetBoostComponent().GetCurrentBoostAmount();
-        if (lastBoostAmt > 0 && boostAmount < lastBoostAmt) {
-            float boostUsed = lastBoostAmt - boostAmount;
-            heatmapGenerator->RecordBoostUsage(position, boostUsed);
-        }
-        lastBoostAmt = (int)boostAmount;
-    }
+    if (recordSessions && !recordingActive) StartRecording();
+    worker->PushSample(game.Now(), car);
     
-    // Calculate distance traveled
-    if (currentSession.positionHistory.size() > 1) {
-        Vector lastPos = currentSession.positionHistory[currentSession.positionHistory.size() - 2];
-        float distance = (position - lastPos).magnitude();
-        currentSession.totalDistance += distance;
+    boostLedger.Tick(game.Now(), car.boost, car.supersonic);
+    PublishLedgerSnapshot();
+    if (game.Now() - lastEfficiencyLogTime >= kEfficiencyLogInterval) {
+        efficiencyLog.Push(boostLedger.Window(kEfficiencyLogInterval).Efficiency());
+        lastEfficiencyLogTime = game.Now();
     }
-    
-    // Calculate average speed
-    if (!currentSession.speedHistory.empty()) {
-        float sum = 0;
-        for (float s : currentSession.speedHistory) sum += s;
-        currentSession.averageSpeed = sum / currentSession.speedHistory.size();
-    }
-    
-    // Limit history size
-    const size_t MAX_HISTORY_SIZE = 10000;
-    if (currentSession.speedHistory.size() > MAX_HISTORY_SIZE) {
-        currentSession.speedHistory.erase(
-            currentSession.speedHistory.begin(),
-            currentSession.speedHistory.begin() + (MAX_HISTORY_SIZE / 2)
-        );
-        currentSession.positionHistory.erase(
-            currentSession.positionHistory.begin(),
-            currentSession.positionHistory.begin() + (MAX_HISTORY_SIZE / 2)
-        );
-    }
-    
-    // Invalidate cached efficiency
-    cachedEfficiency.reset();
+}
+
+void BoostMaster::PublishLedgerSnapshot() {
+    BoostLedgerSnapshot snapshot = boostLedger.Snapshot();
+    std::lock_guard<std::mutex> lock(ledgerSnapshotMutex);
+    ledgerSnapshot = snapshot;
+}
+
+BoostLedgerSnapshot BoostMaster::LedgerSnapshot() const {
+    std::lock_guard<std::mutex> lock(ledgerSnapshotMutex);
+    return ledgerSnapshot;
 }
 
 void BoostMaster::AnalyzePlaystyle() {
-    float boostEfficiency = GetCurrentEfficiency();
-    
-    std::string playstyle = "Balanced";
-    if (boostEfficiency > 80.0f && currentSession.averageSpeed > 1200.0f) {
-        playstyle = "Aggressive";
-    } else if (boostEfficiency < 40.0f && currentSession.averageSpeed < 800.0f) {
-        playstyle = "Defensive";
-    } else if (currentSession.averageSpeed > 1000.0f) {
-        playstyle = "Fast-Paced";
-    } else if (boostEfficiency > 60.0f) {
-        playstyle = "Efficient";
-    }
-    
-    if (currentSession.detectedPlaystyle != playstyle) {
-        currentSession.detectedPlaystyle = playstyle;
-        Logger::Log(LogLevel::INFO, "Analytics", "Detected playstyle: " + playstyle);
-        
-        if (notificationManager) {
-            Notification notif{
-                NotificationType::Custom,
-                "Playstyle detected: " + playstyle,
-                5.0f,
-                false,
-                LinearColor{0.0f, 1.0f, 1.0f, 1.0f}
-            };
-            notificationManager->ShowNotification(notif);
-        }
-    }
+    worker->Post([this, efficiency = GetCurrentEfficiency()] { analytics.AnalyzePlaystyle(efficiency); });
 }
 
 float BoostMaster::GetCurrentEfficiency() const {
-    float currentTime = GetGameTime();
-    if (!cachedEfficiency || (currentTime - lastEfficiencyUpdate) > 1.0f) {
-        float efficiency = 0.0f;
-        if (totalBoostTime > 0.0f) {
-            efficiency = (totalBoostUsed / totalBoostTime) * 100.0f;
-        }
-        cachedEfficiency = efficiency;
-        lastEfficiencyUpdate = currentTime;
-    }
-    return *cachedEfficiency;
+    return boostLedger.Session().Efficiency();
 }
 
 void BoostMaster::GenerateSessionReport() {
-    float sessionDuration = GetGameTime() - currentSession.sessionStartTime;
+    // The metrics belong to the analytics worker, so the report is written there
+    worker->Post([this, now = GetGameTime(), efficiency = GetCurrentEfficiency()] {
+        WriteSessionReport(now, efficiency);
+    });
+}
+
+void BoostMaster::WriteSessionReport(float now, float efficiency) {
+    float sessionDuration = now - analytics.metrics.sessionStartTime;
     
     Logger::Log(LogLevel::INFO, "Report", "=== Session Report ===");
     Logger::Log(LogLevel::INFO, "Report", "Duration: " + std::to_string(sessionDuration) + " seconds");
-    Logger::Log(LogLevel::INFO, "Report", "Distance: " + std::to_string(currentSession.totalDistance) + " units");
-    Logger::Log(LogLevel::INFO, "Report", "Average Speed: " + std::to_string(currentSession.averageSpeed) + " units/s");
-    Logger::Log(LogLevel::INFO, "Report", "Ball Touches: " + std::to_string(currentSession.ballTouches));
-    Logger::Log(LogLevel::INFO, "Report", "Boost Efficiency: " + std::to_string(GetCurrentEfficiency()) + "%");
-    Logger::Log(LogLevel::INFO, "Report", "Playstyle: " + currentSession.detectedPlaystyle);
+    Logger::Log(LogLevel::INFO, "Report", "Distance: " + std::to_string(analytics.metrics.totalDistance) + " units");
+    Logger::Log(LogLevel::INFO, "Report", "Average Speed: " + std::to_string(analytics.metrics.averageSpeed) + " units/s");
+    Logger::Log(LogLevel::INFO, "Report", "Speed Std Dev: " + std::to_string(analytics.metrics.speedStats.StdDev()) +
+               ", Max: " + std::to_string(analytics.metrics.speedStats.Max()) + " units/s");
+    Logger::Log(LogLevel::INFO, "Report", "Last Minute: avg speed " + std::to_string(analytics.metrics.recentSpeed.Mean()) +
+               " (min " + std::to_string(analytics.metrics.recentSpeed.Min()) + ", max " + std::to_string(analytics.metrics.recentSpeed.Max()) +
+               "), distance " + std::to_string(analytics.metrics.recentDistance.Sum()) + " units");
+    auto quantiles = [](const QuantileSketch& sk) {
+        return "p10 " + std::to_string((int)sk.Quantile(0.10)) + ", p50 " + std::to_string((int)sk.Quantile(0.50)) +
+               ", p90 " + std::to_string((int)sk.Quantile(0.90)) + ", p99 " + std::to_string((int)sk.Quantile(0.99));
+    };
+    const auto& sketches = analytics.metrics.sketches;
+    Logger::Log(LogLevel::INFO, "Report", "Speed: " + quantiles(sketches.speed));
+    Logger::Log(LogLevel::INFO, "Report", "Boost Level: " + quantiles(sketches.boost));
+    if (!sketches.boostPerMinute.Empty()) {
+        Logger::Log(LogLevel::INFO, "Report", "Boost Used/Min: " + quantiles(sketches.boostPerMinute));
+    }
+    SessionSketches allTime;
+    if (LoadLongTermSketches(allTime) && !allTime.speed.Empty()) {
+        Logger::Log(LogLevel::INFO, "Report", "All-Time Speed: " + quantiles(allTime.speed));
+        Logger::Log(LogLevel::INFO, "Report", "All-Time Boost Level: " + quantiles(allTime.boost));
+    }
+    Logger::Log(LogLevel::INFO, "Report", "Telemetry (whole session): " + std::to_string(analytics.metrics.archive.Size()) + " frames, " +
+               std::to_string(analytics.metrics.archive.ByteSize() / 1024) + " KB compressed");
+    Logger::Log(LogLevel::INFO, "Report", "Ball Touches: " + std::to_string(analytics.metrics.ballTouches));
+    Logger::Log(LogLevel::INFO, "Report", "Boost Efficiency: " + std::to_string(efficiency) + "%");
+    Logger::Log(LogLevel::INFO, "Report", "Playstyle: " + analytics.metrics.detectedPlaystyle);
     Logger::Log(LogLevel::INFO, "Report", "=====================");
 }
 
@@ -616,72 +868,256 @@ void BoostMaster::RegisterAdvancedHooks() {
         });
     
     // Boost pickup events
-    gameWrapper->HookEvent("Function TAGame.VehiclePickup_Boost_TA.Pickup", 
-        [this](const std::string& eventName) {
-            OnBoostPickup();
+    gameWrapper->HookEventWithCaller<ActorWrapper>("Function TAGame.VehiclePickup_Boost_TA.Pickup",
+        [this](ActorWrapper caller, void* params, const std::string& eventName) {
+            // Pickup(Car_TA Car): the only parameter is the collecting car
+            CarWrapper car = params ? CarWrapper(*reinterpret_cast<uintptr_t*>(params)) : gameWrapper->GetLocalCar();
+            OnBoostPickup(car);
         });
     
-    // Demo events
-    gameWrapper->HookEvent("Function TAGame.Car_TA.Demolish", 
-        [this](const std::string& eventName) {
-            OnCarDemolished();
+    // Demo events; the caller is the demolished car
+    gameWrapper->HookEventWithCaller<CarWrapper>("Function TAGame.Car_TA.Demolish",
+        [this](CarWrapper caller, void* params, const std::string& eventName) {
+            OnCarDemolished(caller);
         });
     
-    // Input events for boost tracking
+    // Input events for boost tracking; fires once per physics tick per car, so the
+    // local car's call drives the telemetry scheduler
     gameWrapper->HookEventWithCaller<CarWrapper>("Function TAGame.Car_TA.SetVehicleInput",
         [this](CarWrapper caller, void* params, const std::string& eventName) {
             if (caller.IsNull()) return;
             OnBoostInput(caller);
+            
+            CarWrapper localCar = gameWrapper->GetLocalCar();
+            if (localCar.IsNull() || localCar.memory_address != caller.memory_address) return;
+            telemetryScheduler.Advance(std::chrono::duration<double>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
         });
     
     Logger::Log(LogLevel::INFO, "Events", "Advanced event hooks registered");
 }
 
-void BoostMaster::OnGoalScored() {
-    Logger::Log(LogLevel::INFO, "Events", "Goal scored!");
+void BoostMaster::RegisterTelemetryStages() {
+    sampleStage = telemetryScheduler.AddStage("sample", cvarSampleRate, [this](float) {
+        UpdatePerformanceMetrics();
+    });
+    coachingStage = telemetryScheduler.AddStage("coaching", cvarCoachingRate, [this](float) {
+        CheckCoachingTriggers();
+        UpdateBoostRoute();
+    });
+    // Notifications raised on the worker are shown here; they age by dt, so let them
+    // catch up a few periods after a hitch
+    telemetryScheduler.AddStage("notifications", 30.0f, [this](float dt) {
+        if (!notificationManager) return;
+        Notification notif;
+        while (worker->PopNotification(notif)) {
+            notificationManager->ShowNotification(notif);
+        }
+        notificationManager->Update(dt);
+    }, 4);
+}
+
+void BoostMaster::PrintSchedulerStats() {
+    Logger::Log(LogLevel::INFO, "Scheduler", "Ticks: " + std::to_string(telemetryScheduler.TickCount()) +
+        " @ " + std::to_string((int)telemetryScheduler.TickRate()) + " Hz, dropped: " +
+        std::to_string(telemetryScheduler.DroppedTicks()));
+    for (int i = 0; i < (int)telemetryScheduler.StageCount(); ++i) {
+        const auto& stats = telemetryScheduler.GetStats(i);
+        std::ostringstream line;
+        line << std::fixed << std::setprecision(3)
+             << telemetryScheduler.StageName(i) << " (" << telemetryScheduler.StageRate(i) << " Hz): "
+             << stats.runs << " runs, " << stats.skipped << " skipped, " << stats.overruns << " overruns, "
+             << "last " << stats.lastMs << "ms, max " << stats.maxMs << "ms";
+        Logger::Log(LogLevel::INFO, "Scheduler", line.str());
+    }
+    AnalyticsWorkerStats stats = worker->Stats();
+    Logger::Log(LogLevel::INFO, "Scheduler", "Worker: " + std::to_string(stats.pushed) + " records queued, " +
+        std::to_string(stats.processed) + " processed, " + std::to_string(stats.dropped) + " dropped (queue full), " +
+        std::to_string(stats.queued) + "/" + std::to_string(AnalyticsWorker::kQueueCapacity) + " pending, high water " +
+        std::to_string(stats.highWater) + ", " + std::to_string(stats.notificationsDropped) + " notifications dropped");
+}
+
+void BoostMaster::StartRecording() {
+    // Set even if the open fails, so a bad path is not retried every sample; the
+    // next map load clears it
+    recordingActive = true;
+    try {
+        std::filesystem::create_directories("data/recordings");
+        auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::stringstream name;
+        name << "data/recordings/session_" << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S") << ".bmrec";
+        
+        worker->Post([this, path = name.str(), map = gameWrapper->GetCurrentMap(), rate = cvarSampleRate, keep = cvarRecordingKeep] {
+            try {
+                PruneRecordings("data/recordings", keep);
+            }
+            catch (const std::exception& ex) {
+                Logger::Log(LogLevel::WARNING, "Recording", "Could not prune old recordings: " + std::string(ex.what()));
+            }
+            if (recorder.Open(path, map, rate)) {
+                Logger::Log(LogLevel::INFO, "Recording", "Recording to " + path);
+            }
+            else {
+                Logger::Log(LogLevel::WARNING, "Recording", "Could not open " + path + ", not recording this map");
+            }
+        });
+    }
+    catch (const std::exception& ex) {
+        Logger::Log(LogLevel::ERROR, "Recording", "Failed to start recording: " + std::string(ex.what()));
+        recordSessions = false;
+    }
+}
+
+void BoostMaster::StopRecording() {
+    if (!recordingActive) return;
+    recordingActive = false;
+    worker->Post([this] {
+        if (!recorder.IsOpen()) return;
+        uint64_t frames = recorder.FrameCount();
+        std::string path = recorder.Path();
+        recorder.Close();
+        Logger::Log(LogLevel::INFO, "Recording", "Saved " + std::to_string(frames) + " frames to " + path);
+    });
+}
+
+void BoostMaster::InspectRecording(const std::string& path) {
+    SessionRecording recording;
+    if (!recording.Open(path)) {
+        Logger::Log(LogLevel::WARNING, "Recording", "Not a readable recording: " + path);
+        return;
+    }
     
-    if (notificationManager) {
-        Notification notif{
-            NotificationType::GoalScored,
-            "GOAL! Great shot!",
-            3.0f,
-            true,
-            LinearColor{0.0f, 1.0f, 0.0f, 1.0f}
-        };
-        notificationManager->ShowNotification(notif);
+    // Scan the mapped columns directly; nothing is copied or parsed
+    double speedSum = 0.0, boostUsed = 0.0;
+    float firstTime = 0.0f, lastTime = 0.0f;
+    for (size_t c = 0; c < recording.ChunkCount(); ++c) {
+        RecordingChunk chunk = recording.Chunk(c);
+        for (float v : chunk.speed) speedSum += v;
+        for (float v : chunk.boostUsed) boostUsed += v;
+        if (c == 0) firstTime = chunk.time.front();
+        lastTime = chunk.time.back();
+    }
+    
+    const RecordingHeader& header = recording.Header();
+    uint64_t frames = recording.FrameCount();
+    Logger::Log(LogLevel::INFO, "Recording", path + (recording.Complete() ? "" : " (recovered, no footer)"));
+    Logger::Log(LogLevel::INFO, "Recording", "Map: " + std::string(header.mapName, strnlen(header.mapName, sizeof(header.mapName))) +
+               ", " + std::to_string((int)header.tickRate) + " Hz");
+    Logger::Log(LogLevel::INFO, "Recording", "Frames: " + std::to_string(frames) + " in " + std::to_string(recording.ChunkCount()) +
+               " chunks, " + std::to_string(lastTime - firstTime) + " seconds");
+    Logger::Log(LogLevel::INFO, "Recording", "Events: " + std::to_string(recording.Events().size()));
+    if (frames > 0) {
+        Logger::Log(LogLevel::INFO, "Recording", "Average Speed: " + std::to_string(speedSum / frames) +
+                   " units/s, Boost Used: " + std::to_string(boostUsed));
     }
 }
 
-void BoostMaster::OnBallHit() {
-    currentSession.ballTouches++;
+void BoostMaster::ReplayRecordings(const std::string& path) {
+    std::vector<std::string> files;
+    try {
+        if (std::filesystem::is_directory(path)) {
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                if (entry.path().extension() == ".bmrec") files.push_back(entry.path().string());
+            }
+            std::sort(files.begin(), files.end());
+        }
+        else {
+            files.push_back(path);
+        }
+    }
+    catch (const std::exception& ex) {
+        Logger::Log(LogLevel::ERROR, "Replay", "Cannot list " + path + ": " + ex.what());
+        return;
+    }
     
-    if (notificationManager && currentSession.ballTouches % 50 == 0) {
-        Notification notif{
-            NotificationType::BallHit,
-            "Ball touches: " + std::to_string(currentSession.ballTouches),
-            2.0f,
-            false,
-            LinearColor{1.0f, 1.0f, 0.0f, 1.0f}
-        };
-        notificationManager->ShowNotification(notif);
+    if (replayRunning.load()) {
+        Logger::Log(LogLevel::WARNING, "Replay", "A replay is already running");
+        return;
     }
+    if (replayThread.joinable()) replayThread.join();
+    
+    // The active recording is still being written; close it so it can be read back
+    StopRecording();
+    auto closed = std::make_shared<std::promise<void>>();
+    std::future<void> recordingClosed = closed->get_future();
+    worker->Post([closed] { closed->set_value(); });
+    
+    ReplayOptions options;
+    options.coachingRate = cvarCoachingRate;
+    options.playstyleRate = cvarPlaystyleRate;
+    options.lowBoostThreshold = cvarLowBoostThresh;
+    
+    // Replays can take a while. They get their own thread rather than the analytics
+    // worker, whose record ring would fill and drop live samples in the meantime.
+    replayRunning.store(true);
+    replayCancel.store(false);
+    replayThread = std::thread([this, files, options, recordingClosed = std::move(recordingClosed)] {
+        recordingClosed.wait();
+        try {
+            for (const std::string& file : files) {
+                if (replayCancel.load()) break;
+                SessionAnalytics replayed;
+                ReplaySummary summary;
+                if (!SessionReplay::Run(file, replayed, options, summary)) {
+                    Logger::Log(LogLevel::WARNING, "Replay", "Not a readable recording: " + file);
+                    continue;
+                }
+                std::ostringstream line;
+                line << std::fixed << std::setprecision(1) << file << ": " << summary.frames << " frames, "
+                     << summary.sessionSeconds << "s in " << summary.wallSeconds * 1000.0 << "ms (" << summary.Speedup() << "x), "
+                     << summary.notifications << " notifications, avg speed " << replayed.metrics.averageSpeed
+                     << ", boost efficiency " << summary.boostEfficiency << "%"
+                     << ", playstyle " << replayed.metrics.detectedPlaystyle;
+                Logger::Log(LogLevel::INFO, "Replay", line.str());
+            }
+        }
+        catch (const std::exception& ex) {
+            Logger::Log(LogLevel::ERROR, "Replay", "Replay failed: " + std::string(ex.what()));
+        }
+        replayRunning.store(false);
+    });
 }
 
-void BoostMaster::OnBoostPickup() {
-    // This will be called when player picks up boost pads
-    Logger::Log(LogLevel::DEBUG, "Events", "Boost pickup detected");
+void BoostMaster::OnGoalScored() {
+    // Kickoff follows; the boost reset it brings is not usage
+    boostLedger.NoteRespawn(GetGameTime());
+    worker->PushEvent(RecordedEventType::Goal, GetGameTime());
 }
 
-void BoostMaster::OnCarDemolished() {
-    currentSession.totalDemos++;
-    Logger::Log(LogLevel::INFO, "Events", "Car demolished! Total: " + std::to_string(currentSession.totalDemos));
+void BoostMaster::OnBallHit() {
+    worker->PushEvent(RecordedEventType::BallTouch, GetGameTime());
+}
+
+void BoostMaster::OnBoostPickup(CarWrapper car) {
+    if (car.IsNull()) return;
+
+    padTracker.Sync(BoostPadHelper::GetCachedPads(this));
+    int pad = padTracker.OnPickup(BoostPadHelper::GetCachedSpatialIndex(this), car.GetLocation(), GetGameTime());
+    CarWrapper localCar = gameWrapper->GetLocalCar();
+    const bool local = !localCar.IsNull() && localCar.memory_address == car.memory_address;
+    worker->PushEvent(RecordedEventType::BoostPickup, GetGameTime(), pad, local ? Bmrec::kEventLocalCar : 0);
+    
+    const auto& pads = BoostPadHelper::GetCachedPads(this);
+    if (pad >= 0 && pad < (int)pads.size() && local) {
+        boostLedger.NotePickup(pads[pad].type == PadType::Big ? BoostSource::BigPad : BoostSource::SmallPad, GetGameTime());
+    }
+    Logger::Log(LogLevel::DEBUG, "Events", "Boost pickup detected at pad " + std::to_string(pad));
+}
+
+void BoostMaster::OnCarDemolished(CarWrapper car) {
+    CarWrapper localCar = gameWrapper->GetLocalCar();
+    const bool local = !car.IsNull() && !localCar.IsNull() && localCar.memory_address == car.memory_address;
+    if (local) {
+        boostLedger.NoteRespawn(GetGameTime());
+    }
+    worker->PushEvent(RecordedEventType::Demolished, GetGameTime(), -1, local ? Bmrec::kEventLocalCar : 0);
 }
 
 void BoostMaster::OnBoostInput(CarWrapper caller) {
     if (caller.IsNull()) return;
     
     // Track boost usage patterns
-    float boostAmount = caller.GetBoostComponent().GetCurrentBoostAmount();
+    float boostAmount = BoostPercent(caller.GetBoostComponent().GetCurrentBoostAmount());
     if (boostAmount > 0) {
         // Player is actively boosting
     }
@@ -690,60 +1126,30 @@ void BoostMaster::OnBoostInput(CarWrapper caller) {
 void BoostMaster::CheckCoachingTriggers() {
     if (!gameWrapper->IsInGame()) return;
     
+    // Coaching runs on the worker; hand it the inputs that live on the game thread
+    worker->SetPadLayout(BoostPadHelper::GetCachedPads(this));
+    worker->SetCoachingInputs(cvarLowBoostThresh, GetCurrentEfficiency());
+}
+
+void BoostMaster::UpdateBoostRoute() {
+    PerformanceProfiler::ScopedTimer timer("UpdateBoostRoute");
+
+    coachRoute = BoostRoute{};
+    if (!gameWrapper->IsInGame()) return;
+
     auto car = gameWrapper->GetLocalCar();
-    if (car.IsNull() || !notificationManager) return;
-    
-    float boostAmount = car.GetBoostComponent().GetCurrentBoostAmount();
-    Vector carPos = car.GetLocation();
-    
-    // Low boost coaching
-    if (boostAmount < cvarLowBoostThresh) {
-        const auto& pads = BoostPadHelper::GetCachedPads(this);
-        float minDistance = FLT_MAX;
-        
-        for (const auto& pad : pads) {
-            float dist = (carPos - pad.location).magnitude();
-            if (dist < minDistance) {
-                minDistance = dist;
-            }
-        }
-        
-        if (minDistance < 1000.0f && minDistance > 0.0f) {
-            static float lastLowBoostNotif = 0.0f;
-            float currentTime = GetGameTime();
-            
-            if (currentTime - lastLowBoostNotif > 5.0f) { // Don't spam notifications
-                Notification notif{
-                    NotificationType::LowBoost,
-                    "Boost pad nearby - " + std::to_string((int)minDistance) + " units",
-                    3.0f,
-                    false,
-                    LinearColor{1.0f, 1.0f, 0.0f, 1.0f}
-                };
-                notificationManager->ShowNotification(notif);
-                lastLowBoostNotif = currentTime;
-            }
-        }
-    }
-    
-    // High efficiency praise
-    float efficiency = GetCurrentEfficiency();
-    if (efficiency > 85.0f) {
-        static float lastEfficiencyNotif = 0.0f;
-        float currentTime = GetGameTime();
-        
-        if (currentTime - lastEfficiencyNotif > 30.0f) {
-            Notification notif{
-                NotificationType::HighEfficiency,
-                "Excellent boost efficiency: " + std::to_string((int)efficiency) + "%!",
-                4.0f,
-                false,
-                LinearColor{0.0f, 1.0f, 0.0f, 1.0f}
-            };
-            notificationManager->ShowNotification(notif);
-            lastEfficiencyNotif = currentTime;
-        }
-    }
+    if (car.IsNull()) return;
+
+    BoostRouteQuery query;
+    query.carLocation = car.GetLocation();
+    query.carSpeed = car.GetVelocity().magnitude();
+    query.carBoost = BoostPercent(car.GetBoostComponent().GetCurrentBoostAmount());
+    query.now = GetGameTime();
+
+    padTracker.Sync(BoostPadHelper::GetCachedPads(this));
+    query.padRespawnAt = padTracker.RespawnDeadlines();
+
+    coachRoute = BoostPadRouter::FindBestRoute(BoostPadHelper::GetCachedGraph(this), query);
 }
 
 void BoostMaster::RenderAdvancedOverlay(CanvasWrapper canvas) {
@@ -799,26 +1205,38 @@ void BoostMaster::DrawBoostEfficiencyGauge(CanvasWrapper canvas, Vector2 screenS
 
 void BoostMaster::DrawWorldSpaceIndicators(CanvasWrapper canvas) {
     const auto& pads = BoostPadHelper::GetCachedPads(this);
+    if (pads.empty()) return;
+    auto car = gameWrapper->GetLocalCar();
+    if (car.IsNull()) return;
+
+    // Distances from the car to every pad in one batched pass; far pads are skipped
+    // before projecting
+    constexpr float kIndicatorRange = 6000.0f;
+    alignas(32) float distSq[kMaxBoostPads];
+    BoostPadHelper::GetCachedPadSoA(this).SquaredDistances(car.GetLocation(), distSq);
+
+    padTracker.Sync(pads);
+    float now = GetGameTime();
+    Vector2 screenSize = canvas.GetSize();
+    int count = std::min((int)pads.size(), kMaxBoostPads);
     
-    for (const auto& pad : pads) {
+    for (int i = 0; i < count; ++i) {
+        if (distSq[i] > kIndicatorRange * kIndicatorRange) continue;
+        const auto& pad = pads[i];
         Vector2 screenPos = canvas.Project(pad.location);
-        Vector2 screenSize = canvas.GetSize();
         
         if (screenPos.X >= 0 && screenPos.X <= screenSize.X && 
             screenPos.Y >= 0 && screenPos.Y <= screenSize.Y) {
             
-            float radius = pad.type == PadType::Big ? 15.0f : 8.0f;
+            int radius = pad.type == PadType::Big ? 15 : 8;
             LinearColor color = pad.type == PadType::Big ? 
                 LinearColor{1.0f, 0.5f, 0.0f, 0.8f} :  // Orange for big pads
                 LinearColor{0.0f, 0.5f, 1.0f, 0.8f};   // Blue for small pads
+            if (!padTracker.IsUp(i, now)) color.A = 0.25f; // Fade pads that are respawning
             
             canvas.SetColor(color);
-            \
-
-// draw circle via ImGui draw list
-ImDrawList* dl = ImGui::GetBackgroundDrawList();
-			dl->AddCircle(circleCenter, circleRadius, IM_COL32(255, 255, 255, 255), 32, 1.0f);
-
+            canvas.SetPosition(Vector2{screenPos.X - radius, screenPos.Y - radius});
+            canvas.FillBox(Vector2{radius * 2, radius * 2});
         }
     }
 }
@@ -8,15 +8,28 @@
 #include <functional>
 #include <optional>
 #include <chrono>
+#include <algorithm>
+#include <span>
+#include <mutex>
+#include <thread>
+#include <atomic>
 #include "bakkesmod/plugin/bakkesmodplugin.h"
 #include "bakkesmod/wrappers/CanvasWrapper.h"
+#include "BoostPadRouter.h"
+#include "BoostPadTracker.h"
+#include "Logger.h"
+#include "SessionAnalytics.h"
+#include "TelemetryScheduler.h"
+#include "SessionRecording.h"
+#include "AnalyticsWorker.h"
+#include "PlotSeries.h"
+#include "BoostLedger.h"
 
 // Forward declarations to avoid circular dependencies
 class BoostPadHelper;
 class BoostHUDWindow;
 class BoostSettingsWindow;
 class NotificationManager;
-class HeatmapGenerator;
 
 struct TrainingDrill {
     std::string name;
@@ -26,51 +39,6 @@ struct TrainingDrill {
     float ballVelX, ballVelY, ballVelZ;
 };
 
-// Advanced Analytics System
-struct PerformanceMetrics {
-    float sessionStartTime = 0.0f;
-    float totalDistance = 0.0f;
-    float averageSpeed = 0.0f;
-    int totalDemos = 0;
-    int totalSaves = 0;
-    int ballTouches = 0;
-    std::vector<float> speedHistory;
-    std::vector<Vector> positionHistory;
-    std::string detectedPlaystyle = "Balanced";
-    
-    void Reset() {
-        sessionStartTime = 0.0f;
-        totalDistance = 0.0f;
-        averageSpeed = 0.0f;
-        totalDemos = 0;
-        totalSaves = 0;
-        ballTouches = 0;
-        speedHistory.clear();
-        positionHistory.clear();
-        detectedPlaystyle = "Balanced";
-    }
-};
-
-// Notification System
-enum class NotificationType {
-    LowBoost,
-    HighEfficiency,
-    PositioningSuggestion,
-    BoostPadTiming,
-    GoalScored,
-    BallHit,
-    Custom
-};
-
-struct Notification {
-    NotificationType type;
-    std::string message;
-    float duration;
-    bool soundEnabled;
-    LinearColor color;
-    float timeShown = 0.0f;
-};
-
 class NotificationManager {
 public:
     void ShowNotification(const Notification& notif);
@@ -85,54 +53,6 @@ private:
     const float MAX_NOTIFICATIONS = 5;
 };
 
-// Heatmap System
-class HeatmapGenerator {
-public:
-    struct HeatmapPoint {
-        Vector position;
-        float intensity;
-        float timestamp;
-    };
-    
-    void RecordPosition(Vector pos, float intensity = 1.0f);
-    void RecordBoostUsage(Vector pos, float boostUsed);
-    void GenerateBoostUsageHeatmap();
-    void GeneratePositionHeatmap();
-    void ExportHeatmap(const std::string& filename);
-    void ClearData();
-    
-    const std::vector<HeatmapPoint>& GetHeatmapData() const { return heatmapData; }
-    
-private:
-    std::vector<HeatmapPoint> heatmapData;
-    std::vector<HeatmapPoint> boostUsageData;
-    static const int GRID_SIZE = 100;
-    float positionGrid[100][100] = {};
-    float boostGrid[100][100] = {};
-    
-    void WorldToGrid(Vector worldPos, int& gridX, int& gridY);
-};
-
-// Logging System
-enum class LogLevel {
-    DEBUG,
-    INFO,
-    WARNING,
-    ERROR
-};
-
-class Logger {
-public:
-    static void Log(LogLevel level, const std::string& category, const std::string& message);
-    static void SetLogLevel(LogLevel level) { currentLogLevel = level; }
-    
-private:
-    static LogLevel currentLogLevel;
-    static std::string GetLogPrefix(LogLevel level);
-    static std::string GetTimestamp();
-    static void WriteToLogFile(const std::string& message);
-};
-
 // Performance Profiler
 class PerformanceProfiler {
 public:
@@ -162,6 +82,8 @@ public:
     void ResetStats();
     void PrintPadPath();
     void saveMatch();
+    void SaveLongTermSketches();
+    bool LoadLongTermSketches(SessionSketches& out);
     void loadHistory();
 
     // Training drill management
@@ -177,16 +99,30 @@ public:
     void AnalyzePlaystyle();
     void GenerateSessionReport();
     float GetCurrentEfficiency() const;
+    // HUD copy of the ledger figures, safe to read from the render thread
+    void PublishLedgerSnapshot();
+    BoostLedgerSnapshot LedgerSnapshot() const;
 
     // Event handlers
     void OnGoalScored();
     void OnBallHit();
-    void OnBoostPickup();
-    void OnCarDemolished();
+    void OnBoostPickup(CarWrapper car);
+    void OnCarDemolished(CarWrapper car);
     void OnBoostInput(CarWrapper caller);
 
     // Coaching system
     void CheckCoachingTriggers();
+    void UpdateBoostRoute();
+
+    // Fixed-rate telemetry
+    void RegisterTelemetryStages();
+    void PrintSchedulerStats();
+
+    // Session recordings (.bmrec)
+    void StartRecording();
+    void StopRecording();
+    void InspectRecording(const std::string& path);
+    void ReplayRecordings(const std::string& path);
     void RegisterAdvancedHooks();
 
     // Rendering
@@ -202,28 +138,63 @@ public:
 
     // Core data
     std::vector<int> lastPath;
+    BoostRoute coachRoute;
+    BoostPadTracker padTracker;
     float cvarLowBoostThresh = 20.0f;
     float cvarLowBoostTime = 5.0f;
     float cvarMaxBoostTime = 5.0f;
-    float totalBoostUsed = 0.0f;
-    float totalBoostTime = 0.0f;
-    float avgBoostPerMinute = 0.0f;
-    int bigPads = 0;
-    int smallPads = 0;
-    int lastBoostAmt = -1;
-
-    std::vector<float> efficiencyLog;
-    std::vector<float> historyLog;
+    float cvarSampleRate = 120.0f;
+    float cvarCoachingRate = 10.0f;
+    float cvarPlaystyleRate = 1.0f;
+    // Boost spent and collected by the local car, integrated at the sample rate.
+    // Game thread only; the HUD reads the snapshot published after each tick.
+    BoostLedger boostLedger;
+    mutable std::mutex ledgerSnapshotMutex;
+    BoostLedgerSnapshot ledgerSnapshot;
+    // Ledger totals when the current match began; boost_history.csv rows are per match
+    BoostLedgerMark matchStart;
+    static constexpr float kEfficiencyLogInterval = 10.0f; // seconds per efficiencyLog entry
+    float lastEfficiencyLogTime = 0.0f;
+
+    PlotSeries efficiencyLog;
+    PlotSeries historyLog;
     std::map<std::string, TrainingDrill> drills;
 
-    // Advanced systems
-    PerformanceMetrics currentSession;
+    // Advanced systems. analytics and recorder belong to the analytics worker while
+    // it runs; game-thread code reaches them through worker->Post
+    SessionAnalytics analytics;
     std::unique_ptr<NotificationManager> notificationManager;
-    std::unique_ptr<HeatmapGenerator> heatmapGenerator;
+    std::unique_ptr<AnalyticsWorker> worker;
+    
+    // Stages run from the SetVehicleInput hook of the local car
+    TelemetryScheduler telemetryScheduler;
+    int sampleStage = -1;
+    int coachingStage = -1;
+    
+    // Full-rate session recording, written incrementally to data/recordings. Off by
+    // default (about 19 MB per hour of play); only the newest recordings are kept.
+    SessionRecorder recorder;
+    bool recordSessions = false;
+    bool recordingActive = false;
+    int cvarRecordingKeep = 20;
+    // boostmaster_replay batches run on their own thread so the live worker keeps
+    // draining samples and events; joined before the next batch and on unload
+    std::thread replayThread;
+    std::atomic<bool> replayRunning{false};
+    std::atomic<bool> replayCancel{false};
+    
+    // Heatmap history: decayed view half-life and recent view length
+    float cvarHeatmapHalfLife = 300.0f;
+    int cvarHeatmapRecentMinutes = 5;
+    // Minutes of heatmap samples kept for timelapses
+    int cvarHeatmapTimelapseMinutes = HeatmapGenerator::DEFAULT_RETAINED_MINUTES;
+    // Heatmap grid: cell edge in unreal units and ground/low air/high air split
+    float cvarHeatmapCellSize = 100.0f;
+    bool cvarHeatmapHeightBands = true;
+    // Kernel density bandwidth in unreal units; 0 keeps plain bins
+    float cvarHeatmapKernel = 0.0f;
+    int cvarHeatmapImageWidth = 1024;
     
-    // Performance optimization
-    mutable std::optional<float> cachedEfficiency;
-    mutable float lastEfficiencyUpdate = 0.0f;
     float lastUpdateTime = 0.0f;
 
 private:
@@ -233,5 +204,6 @@ private:
     
     void InitializeAdvancedSystems();
     void CleanupAdvancedSystems();
+    void WriteSessionReport(float now, float efficiency);
     float GetGameTime() const;
 };
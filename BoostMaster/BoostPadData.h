@@ -1,107 +1,233 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <string_view>
+#include <array>
+#include <cstdint>
 #include <algorithm>
 #include "bakkesmod/wrappers/WrapperStructs.h"
 
 // PadType for filtering and coloring
 enum class PadType { Big, Small };
 
+// Upper bound on pads per layout; sizes fixed per-pad tables and route buffers
+constexpr int kMaxBoostPads = 64;
+
+// Seconds until a collected pad becomes available again
+constexpr float kBigPadRespawnTime = 10.0f;
+constexpr float kSmallPadRespawnTime = 4.0f;
+
+// The SDK reports boost as 0-1; pad amounts, thresholds and CarSnapshot::boost use 0-100
+constexpr float BoostPercent(float sdkBoostAmount) { return sdkBoostAmount * 100.0f; }
+
 struct StaticBoostPad {
     Vector location;
     float amount; // 100 for big, 12 for small
     PadType type;
 };
 
+// Compile-time pad definition; Vector is not a literal type, so layouts are stored
+// as plain floats and expanded into StaticBoostPad once per process
+struct StaticPadDef {
+    float x, y, z;
+    float amount;
+    PadType type;
+};
+
+enum class PadLayout : uint8_t { None, Standard, Hoops, Dropshot, SnowDay };
+
 // Standard pad layout for all standard maps
 // Big pads: corners and sides, Small pads: between big pads
-static const std::vector<StaticBoostPad> StandardPads = {
-    { Vector(-3584, 0, 70), 100, PadType::Big },
-    { Vector(3584, 0, 70), 100, PadType::Big },
-    { Vector(0, 5120, 70), 100, PadType::Big },
-    { Vector(0, -5120, 70), 100, PadType::Big },
-    { Vector(-2048, 2560, 70), 100, PadType::Big },
-    { Vector(2048, 2560, 70), 100, PadType::Big },
-    { Vector(-2048, -2560, 70), 100, PadType::Big },
-    { Vector(2048, -2560, 70), 100, PadType::Big },
-    { Vector(-2816, 2816, 70), 12, PadType::Small },
-    { Vector(0, 2816, 70), 12, PadType::Small },
-    { Vector(2816, 2816, 70), 12, PadType::Small },
-    { Vector(-2816, 0, 70), 12, PadType::Small },
-    { Vector(2816, 0, 70), 12, PadType::Small },
-    { Vector(-2816, -2816, 70), 12, PadType::Small },
-    { Vector(0, -2816, 70), 12, PadType::Small },
-    { Vector(2816, -2816, 70), 12, PadType::Small },
-};
+constexpr auto StandardPadDefs = std::to_array<StaticPadDef>({
+    { -3584, 0, 70, 100, PadType::Big },
+    { 3584, 0, 70, 100, PadType::Big },
+    { 0, 5120, 70, 100, PadType::Big },
+    { 0, -5120, 70, 100, PadType::Big },
+    { -2048, 2560, 70, 100, PadType::Big },
+    { 2048, 2560, 70, 100, PadType::Big },
+    { -2048, -2560, 70, 100, PadType::Big },
+    { 2048, -2560, 70, 100, PadType::Big },
+    { -2816, 2816, 70, 12, PadType::Small },
+    { 0, 2816, 70, 12, PadType::Small },
+    { 2816, 2816, 70, 12, PadType::Small },
+    { -2816, 0, 70, 12, PadType::Small },
+    { 2816, 0, 70, 12, PadType::Small },
+    { -2816, -2816, 70, 12, PadType::Small },
+    { 0, -2816, 70, 12, PadType::Small },
+    { 2816, -2816, 70, 12, PadType::Small },
+});
 
 // Hoops (Dunk House) pad layout
-static const std::vector<StaticBoostPad> HoopsPads = {
-    { Vector(-2048, 0, 70), 100, PadType::Big },
-    { Vector(2048, 0, 70), 100, PadType::Big },
-    { Vector(0, 2560, 70), 100, PadType::Big },
-    { Vector(0, -2560, 70), 100, PadType::Big },
-    { Vector(-1024, 1280, 70), 12, PadType::Small },
-    { Vector(1024, 1280, 70), 12, PadType::Small },
-    { Vector(-1024, -1280, 70), 12, PadType::Small },
-    { Vector(1024, -1280, 70), 12, PadType::Small },
-};
+constexpr auto HoopsPadDefs = std::to_array<StaticPadDef>({
+    { -2048, 0, 70, 100, PadType::Big },
+    { 2048, 0, 70, 100, PadType::Big },
+    { 0, 2560, 70, 100, PadType::Big },
+    { 0, -2560, 70, 100, PadType::Big },
+    { -1024, 1280, 70, 12, PadType::Small },
+    { 1024, 1280, 70, 12, PadType::Small },
+    { -1024, -1280, 70, 12, PadType::Small },
+    { 1024, -1280, 70, 12, PadType::Small },
+});
 
 // Dropshot pad layout (no pads, but included for completeness)
-static const std::vector<StaticBoostPad> DropshotPads = {};
-
-// Snow Day (throwback stadium) pad layout
-static const std::vector<StaticBoostPad> SnowDayPads = StandardPads;
-
-// Rumble uses StandardPads
-
-// Map lookup function with documentation for each map
-inline const std::vector<StaticBoostPad>& GetStaticBoostPadsForMap(const std::string& mapName) {
-    // Lowercase map name for robust matching
-    std::string lowerMap = mapName;
-    std::transform(lowerMap.begin(), lowerMap.end(), lowerMap.begin(), ::tolower);
-    // All standard map names and variants (lowercase for comparison)
-    static const std::vector<std::string> standardMaps = {
-        "stadium_p", "stadium_p_day", "stadium_p_stormy", "stadium_p_night",
-        "championsfield_p", "championsfield_p_night",
-        "eurostadium_p", "eurostadium_p_night", "eurostadium_p_snowy",
-        "trainstation_p", "trainstation_p_night", "trainstation_p_dawn",
-        "utopiastadium_p", "utopiastadium_p_dusk", "utopiastadium_p_snowy",
-        "beach_p", "beach_p_night", "beach_p_sunset",
-        "neotokyo_standard_p", "neotokyo_standard_p_night",
-        "haunted_trainstation_p", "chn_stadium_p", "chn_stadium_p_dusk",
-        "arc_p", "arc_p_day",
-        "wasteland_p", "wasteland_p_night",
-        "farm_p", "farm_p_night", "farm_p_snowy",
-        "aquadome_p",
-        "deadeyecanyon_p", "deadeyecanyon_p_night",
-        "sovereignheights_p",
-        "estadiovida_p",
-        "tokyounderpass_p", "pillars_p", "cosmic_p", "doublegoal_p", "octagon_p", "underpass_p", "utopiaretro_p", "throwbackstadium_p", "rally_p", "rallynight_p", "rallyday_p", "rallysnowy_p"
-    };
-    for (const auto& name : standardMaps) {
-        if (lowerMap == name) return StandardPads;
-    }
+constexpr std::array<StaticPadDef, 0> DropshotPadDefs{};
+
+static_assert(StandardPadDefs.size() <= kMaxBoostPads && HoopsPadDefs.size() <= kMaxBoostPads);
+
+// Map name -> layout, lowercase. Names appearing in more than one list keep the
+// first layout they were registered under.
+struct MapLayoutEntry {
+    std::string_view name;
+    PadLayout layout;
+};
+
+constexpr MapLayoutEntry MapLayouts[] = {
+    // Standard maps and variants
+    { "stadium_p", PadLayout::Standard }, { "stadium_p_day", PadLayout::Standard },
+    { "stadium_p_stormy", PadLayout::Standard }, { "stadium_p_night", PadLayout::Standard },
+    { "championsfield_p", PadLayout::Standard }, { "championsfield_p_night", PadLayout::Standard },
+    { "eurostadium_p", PadLayout::Standard }, { "eurostadium_p_night", PadLayout::Standard },
+    { "eurostadium_p_snowy", PadLayout::Standard },
+    { "trainstation_p", PadLayout::Standard }, { "trainstation_p_night", PadLayout::Standard },
+    { "trainstation_p_dawn", PadLayout::Standard },
+    { "utopiastadium_p", PadLayout::Standard }, { "utopiastadium_p_dusk", PadLayout::Standard },
+    { "utopiastadium_p_snowy", PadLayout::Standard },
+    { "beach_p", PadLayout::Standard }, { "beach_p_night", PadLayout::Standard },
+    { "beach_p_sunset", PadLayout::Standard },
+    { "neotokyo_standard_p", PadLayout::Standard }, { "neotokyo_standard_p_night", PadLayout::Standard },
+    { "haunted_trainstation_p", PadLayout::Standard }, { "chn_stadium_p", PadLayout::Standard },
+    { "chn_stadium_p_dusk", PadLayout::Standard },
+    { "arc_p", PadLayout::Standard }, { "arc_p_day", PadLayout::Standard },
+    { "wasteland_p", PadLayout::Standard }, { "wasteland_p_night", PadLayout::Standard },
+    { "farm_p", PadLayout::Standard }, { "farm_p_night", PadLayout::Standard },
+    { "farm_p_snowy", PadLayout::Standard },
+    { "aquadome_p", PadLayout::Standard },
+    { "deadeyecanyon_p", PadLayout::Standard }, { "deadeyecanyon_p_night", PadLayout::Standard },
+    { "sovereignheights_p", PadLayout::Standard },
+    { "estadiovida_p", PadLayout::Standard },
+    { "tokyounderpass_p", PadLayout::Standard }, { "pillars_p", PadLayout::Standard },
+    { "cosmic_p", PadLayout::Standard }, { "doublegoal_p", PadLayout::Standard },
+    { "octagon_p", PadLayout::Standard }, { "underpass_p", PadLayout::Standard },
+    { "utopiaretro_p", PadLayout::Standard }, { "throwbackstadium_p", PadLayout::Standard },
+    { "rally_p", PadLayout::Standard }, { "rallynight_p", PadLayout::Standard },
+    { "rallyday_p", PadLayout::Standard }, { "rallysnowy_p", PadLayout::Standard },
     // Hoops
-    static const std::vector<std::string> hoopsMaps = {
-        "hoopsstadium_p", "dunkhouse_p"
-    };
-    for (const auto& name : hoopsMaps) {
-        if (lowerMap == name) return HoopsPads;
-    }
+    { "hoopsstadium_p", PadLayout::Hoops }, { "dunkhouse_p", PadLayout::Hoops },
     // Dropshot
-    static const std::vector<std::string> dropshotMaps = {
-        "dropshot_p", "dropshot_doublegoal_p"
-    };
-    for (const auto& name : dropshotMaps) {
-        if (lowerMap == name) return DropshotPads;
-    }
+    { "dropshot_p", PadLayout::Dropshot }, { "dropshot_doublegoal_p", PadLayout::Dropshot },
     // Snow Day
-    static const std::vector<std::string> snowdayMaps = {
-        "throwbackstadium_p", "snowystadium_p"
-    };
-    for (const auto& name : snowdayMaps) {
-        if (lowerMap == name) return SnowDayPads;
+    { "snowystadium_p", PadLayout::SnowDay },
+};
+constexpr int kMapLayoutCount = static_cast<int>(std::size(MapLayouts));
+
+namespace BoostPadDataDetail {
+    constexpr char ToLower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+
+    constexpr bool EqualsIgnoreCase(std::string_view a, std::string_view lowerB) {
+        if (a.size() != lowerB.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (ToLower(a[i]) != lowerB[i]) return false;
+        }
+        return true;
+    }
+
+    // Slot = top bits of a seeded multiplicative mix of the name hash
+    constexpr int kSlotBits = 9;
+    constexpr int kSlotCount = 1 << kSlotBits;
+    constexpr uint8_t kEmptySlot = 0xFF;
+    static_assert(kMapLayoutCount < kEmptySlot);
+
+    constexpr uint32_t Slot(uint32_t hash, uint32_t seed) {
+        return ((hash ^ (seed * 0x9E3779B9u)) * 0x85EBCA6Bu) >> (32 - kSlotBits);
     }
+}
+
+// Case-insensitive FNV-1a; no allocation, usable at compile time
+constexpr uint32_t HashMapName(std::string_view name) {
+    uint32_t h = 2166136261u;
+    for (char c : name) {
+        h ^= static_cast<uint8_t>(BoostPadDataDetail::ToLower(c));
+        h *= 16777619u;
+    }
+    return h;
+}
+
+namespace BoostPadDataDetail {
+    // Smallest seed that sends every known map name to its own slot
+    constexpr uint32_t FindPerfectSeed() {
+        uint32_t hashes[kMapLayoutCount] = {};
+        for (int i = 0; i < kMapLayoutCount; ++i) hashes[i] = HashMapName(MapLayouts[i].name);
+
+        for (uint32_t seed = 0; seed < 100000; ++seed) {
+            uint64_t used[kSlotCount / 64] = {};
+            bool ok = true;
+            for (uint32_t hash : hashes) {
+                uint32_t slot = Slot(hash, seed);
+                uint64_t bit = uint64_t(1) << (slot % 64);
+                if (used[slot / 64] & bit) { ok = false; break; }
+                used[slot / 64] |= bit;
+            }
+            if (ok) return seed;
+        }
+        return UINT32_MAX;
+    }
+
+    constexpr uint32_t kPerfectSeed = FindPerfectSeed();
+    static_assert(kPerfectSeed != UINT32_MAX, "no collision-free seed for the map name table");
+
+    constexpr std::array<uint8_t, kSlotCount> BuildSlotTable() {
+        std::array<uint8_t, kSlotCount> table{};
+        for (auto& slot : table) slot = kEmptySlot;
+        for (int i = 0; i < kMapLayoutCount; ++i) {
+            uint32_t slot = Slot(HashMapName(MapLayouts[i].name), kPerfectSeed);
+            if (table[slot] == kEmptySlot) table[slot] = static_cast<uint8_t>(i);
+        }
+        return table;
+    }
+
+    constexpr auto kSlotTable = BuildSlotTable();
+}
+
+// Resolve a map name (any case) to its pad layout with one hash and one compare
+constexpr PadLayout ResolvePadLayout(std::string_view mapName) {
+    using namespace BoostPadDataDetail;
+    uint8_t index = kSlotTable[Slot(HashMapName(mapName), kPerfectSeed)];
+    if (index == kEmptySlot || !EqualsIgnoreCase(mapName, MapLayouts[index].name)) return PadLayout::None;
+    return MapLayouts[index].layout;
+}
+
+static_assert(ResolvePadLayout("Stadium_P") == PadLayout::Standard);
+static_assert(ResolvePadLayout("dunkhouse_p") == PadLayout::Hoops);
+static_assert(ResolvePadLayout("throwbackstadium_p") == PadLayout::Standard);
+static_assert(ResolvePadLayout("not_a_map") == PadLayout::None);
+
+namespace BoostPadDataDetail {
+    template <size_t N>
+    std::vector<StaticBoostPad> Expand(const std::array<StaticPadDef, N>& defs) {
+        std::vector<StaticBoostPad> pads;
+        pads.reserve(N);
+        for (const auto& d : defs) pads.push_back({ Vector(d.x, d.y, d.z), d.amount, d.type });
+        return pads;
+    }
+}
+
+// Runtime pad list for a layout, expanded from the constexpr definitions on first use
+inline const std::vector<StaticBoostPad>& GetPadLayout(PadLayout layout) {
+    using namespace BoostPadDataDetail;
+    static const std::vector<StaticBoostPad> standard = Expand(StandardPadDefs);
+    static const std::vector<StaticBoostPad> hoops = Expand(HoopsPadDefs);
+    static const std::vector<StaticBoostPad> dropshot = Expand(DropshotPadDefs);
     static const std::vector<StaticBoostPad> empty;
-    return empty;
+    switch (layout) {
+        case PadLayout::Standard: return standard;
+        case PadLayout::Hoops: return hoops;
+        case PadLayout::Dropshot: return dropshot;
+        case PadLayout::SnowDay: return standard; // Snow Day uses the standard layout
+        default: return empty;
+    }
+}
+
+// Map lookup function; allocation-free apart from the one-time layout expansion
+inline const std::vector<StaticBoostPad>& GetStaticBoostPadsForMap(std::string_view mapName) {
+    return GetPadLayout(ResolvePadLayout(mapName));
 }
@@ -1,11 +1,13 @@
 #include "pch.h"
 #include "BoostPadGraph.h"
+#include "BoostPadSoA.h"
 #include <vector>
 #include <queue>
 #include <limits>
 #include <cmath>
+#include <algorithm>
 
-// Helper: Euclidean distance
+// Helper: Euclidean distance between a single pair; batched lookups go through BoostPadSoA
 static float dist(const Vector& a, const Vector& b) {
     float dx = a.X - b.X, dy = a.Y - b.Y, dz = a.Z - b.Z;
     return std::sqrt(dx*dx + dy*dy + dz*dz);
@@ -27,18 +29,114 @@ std::vector<PadNode> BoostPadGraph::Build(const std::vector<StaticBoostPad>& pad
     return graph;
 }
 
-// Find the nearest pad to a location
-int BoostPadGraph::Nearest(const std::vector<PadNode>& graph, const Vector& loc) {
-    float bestDist = std::numeric_limits<float>::max();
-    int bestIdx = 0;
-    for (const auto& node : graph) {
-        float d = dist(node.pad->location, loc);
-        if (d < bestDist) {
-            bestDist = d;
-            bestIdx = node.index;
+static bool hasEdge(const PadNode& node, int other) {
+    return std::find(node.neighbors.begin(), node.neighbors.end(), other) != node.neighbors.end();
+}
+
+static void addEdge(std::vector<PadNode>& graph, int a, int b) {
+    if (a == b || hasEdge(graph[a], b)) return;
+    graph[a].neighbors.push_back(b);
+    graph[b].neighbors.push_back(a);
+}
+
+static void removeEdge(std::vector<PadNode>& graph, int a, int b) {
+    auto& na = graph[a].neighbors;
+    auto& nb = graph[b].neighbors;
+    na.erase(std::remove(na.begin(), na.end(), b), na.end());
+    nb.erase(std::remove(nb.begin(), nb.end(), a), nb.end());
+}
+
+// Sparse k-nearest graph: link each pad to its k nearest, prune edges that a
+// two-hop detour nearly matches (so routes chain through pads), then bridge any
+// disconnected components with their shortest connecting edge
+std::vector<PadNode> BoostPadGraph::Build(const std::vector<StaticBoostPad>& pads, const GraphBuildOptions& options) {
+    if (options.mode == GraphBuildMode::FullyConnected) return Build(pads);
+
+    const int n = std::min(static_cast<int>(pads.size()), kMaxBoostPads);
+    std::vector<PadNode> graph(n);
+    for (int i = 0; i < n; ++i) {
+        graph[i].index = i;
+        graph[i].pad = &pads[i];
+    }
+    if (n < 2) return graph;
+
+    // Pad-to-pad squared distances for every step below come from one batched pass
+    // over the SoA mirror; k nearest neighbours are stored undirected.
+    const int k = std::clamp(options.neighborCount, 1, n - 1);
+    BoostPadSoA soa;
+    soa.Build(pads);
+    const int stride = soa.PaddedCount();
+    std::vector<Vector> origins(n);
+    for (int i = 0; i < n; ++i) origins[i] = pads[i].location;
+    std::vector<float> distSq(static_cast<size_t>(n) * stride);
+    soa.SquaredDistances(origins.data(), n, distSq.data());
+    auto padDist = [&](int a, int b) { return std::sqrt(distSq[static_cast<size_t>(a) * stride + b]); };
+
+    const float maxEdgeSq = options.maxEdgeLength * options.maxEdgeLength;
+    std::vector<std::pair<float, int>> candidates;
+    candidates.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        candidates.clear();
+        for (int j = 0; j < n; ++j) {
+            if (i == j) continue;
+            float d = distSq[static_cast<size_t>(i) * stride + j];
+            if (options.maxEdgeLength > 0.0f && d > maxEdgeSq) continue;
+            candidates.emplace_back(d, j);
         }
+        int take = std::min(k, static_cast<int>(candidates.size()));
+        std::partial_sort(candidates.begin(), candidates.begin() + take, candidates.end());
+        for (int m = 0; m < take; ++m) addEdge(graph, i, candidates[m].second);
     }
-    return bestIdx;
+
+    // Detour pruning, longest edges first. An edge is only dropped while its
+    // two-hop replacement still exists, so pruning never disconnects the graph.
+    if (options.detourRatio >= 1.0f) {
+        std::vector<std::pair<float, std::pair<int, int>>> edges;
+        for (int a = 0; a < n; ++a) {
+            for (int b : graph[a].neighbors) {
+                if (a < b) edges.push_back({ padDist(a, b), { a, b } });
+            }
+        }
+        std::sort(edges.begin(), edges.end(), std::greater<>());
+        for (const auto& [d, e] : edges) {
+            auto [a, b] = e;
+            for (int c : graph[a].neighbors) {
+                if (c == b || !hasEdge(graph[c], b)) continue;
+                float detour = padDist(a, c) + padDist(c, b);
+                if (detour <= options.detourRatio * d) {
+                    removeEdge(graph, a, b);
+                    break;
+                }
+            }
+        }
+    }
+
+    // Bridge components: repeatedly join the component containing pad 0 to its closest outsider
+    std::vector<int> component(n);
+    while (true) {
+        std::fill(component.begin(), component.end(), 0);
+        std::vector<int> stack = { 0 };
+        component[0] = 1;
+        while (!stack.empty()) {
+            int u = stack.back(); stack.pop_back();
+            for (int v : graph[u].neighbors) {
+                if (!component[v]) { component[v] = 1; stack.push_back(v); }
+            }
+        }
+        float best = std::numeric_limits<float>::max();
+        int bestA = -1, bestB = -1;
+        for (int a = 0; a < n; ++a) {
+            if (!component[a]) continue;
+            for (int b = 0; b < n; ++b) {
+                if (component[b]) continue;
+                float d = distSq[static_cast<size_t>(a) * stride + b];
+                if (d < best) { best = d; bestA = a; bestB = b; }
+            }
+        }
+        if (bestA < 0) break;
+        addEdge(graph, bestA, bestB);
+    }
+    return graph;
 }
 
 // Dijkstra's or A* algorithm for shortest path (by distance)
@@ -77,4 +175,54 @@ std::vector<int> BoostPadGraph::FindPath(const std::vector<PadNode>& graph, int
         path.clear();
     }
     return path;
+}
+
+// Floyd-Warshall over the graph edges; layouts are small so O(n^3) once per map is cheap
+PadRouteTable BoostPadGraph::BuildRouteTable(const std::vector<PadNode>& graph) {
+    PadRouteTable table;
+    const int n = static_cast<int>(graph.size());
+    if (n == 0) return table;
+    table.padCount = n;
+    table.nextHop.assign(n * n, -1);
+    table.distance.assign(n * n, std::numeric_limits<float>::max());
+
+    for (int i = 0; i < n; ++i) {
+        table.distance[i * n + i] = 0.0f;
+        table.nextHop[i * n + i] = i;
+        for (int j : graph[i].neighbors) {
+            table.distance[i * n + j] = dist(graph[i].pad->location, graph[j].pad->location);
+            table.nextHop[i * n + j] = j;
+        }
+    }
+    for (int k = 0; k < n; ++k) {
+        for (int i = 0; i < n; ++i) {
+            float ik = table.distance[i * n + k];
+            if (ik == std::numeric_limits<float>::max()) continue;
+            for (int j = 0; j < n; ++j) {
+                float kj = table.distance[k * n + j];
+                if (kj == std::numeric_limits<float>::max()) continue;
+                if (ik + kj < table.distance[i * n + j]) {
+                    table.distance[i * n + j] = ik + kj;
+                    table.nextHop[i * n + j] = table.nextHop[i * n + k];
+                }
+            }
+        }
+    }
+    return table;
+}
+
+int BoostPadGraph::WalkRoute(const PadRouteTable& table, int start, int goal, int* out, int maxLen) {
+    if (table.Empty() || !out || maxLen <= 0) return 0;
+    if (start < 0 || start >= table.padCount || goal < 0 || goal >= table.padCount) return 0;
+    if (table.NextHop(start, goal) == -1) return 0;
+
+    int count = 0;
+    int at = start;
+    out[count++] = at;
+    while (at != goal) {
+        if (count >= maxLen) return 0; // route longer than the buffer
+        at = table.NextHop(at, goal);
+        out[count++] = at;
+    }
+    return count;
 }
\ No newline at end of file
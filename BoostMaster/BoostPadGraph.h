@@ -9,12 +9,43 @@ struct PadNode {
     std::vector<int> neighbors;
 };
 
+// All-pairs shortest routes for one pad layout, stored as flat padCount x padCount
+// tables (row = from pad, column = to pad)
+struct PadRouteTable {
+    int padCount = 0;
+    std::vector<int> nextHop;    // next pad on the route from -> to, -1 if unreachable
+    std::vector<float> distance; // route length from -> to
+
+    bool Empty() const { return padCount == 0; }
+    int NextHop(int from, int to) const { return nextHop[from * padCount + to]; }
+    float Distance(int from, int to) const { return distance[from * padCount + to]; }
+};
+
+// How Build connects pads
+enum class GraphBuildMode {
+    FullyConnected,   // every pad links to every other pad
+    NearestNeighbors  // each pad links to its k nearest, then pruned
+};
+
+struct GraphBuildOptions {
+    GraphBuildMode mode = GraphBuildMode::FullyConnected;
+    int neighborCount = 4;      // k for NearestNeighbors
+    float maxEdgeLength = 0.0f; // drop candidate edges longer than this, 0 = no limit
+    float detourRatio = 0.0f;   // drop a-b if a-c-b is at most ratio * |ab|, 0 = no pruning
+
+    bool operator==(const GraphBuildOptions&) const = default;
+};
+
 class BoostPadGraph {
 public:
     // Build a graph from the static pad list for the current map
     static std::vector<PadNode> Build(const std::vector<StaticBoostPad>& pads);
-    // Find the nearest pad to a location
-    static int Nearest(const std::vector<PadNode>& graph, const Vector& loc);
+    // Build a graph using the given mode; sparse modes stay connected and have O(n*k) edges
+    static std::vector<PadNode> Build(const std::vector<StaticBoostPad>& pads, const GraphBuildOptions& options);
     // Find a path between two pad indices (Dijkstra or A*)
     static std::vector<int> FindPath(const std::vector<PadNode>& graph, int start, int goal, bool useAStar = false);
+    // Precompute next-hop and distance tables for every pad pair (Floyd-Warshall)
+    static PadRouteTable BuildRouteTable(const std::vector<PadNode>& graph);
+    // Walk a precomputed route into out (no allocation); returns pads written, 0 if none
+    static int WalkRoute(const PadRouteTable& table, int start, int goal, int* out, int maxLen);
 };
@@ -9,43 +9,101 @@
 
 // Cache for the last used map and its pads
 namespace {
-    std::string cachedMapName;
+    bool mapLoadPending = true;
+    uint32_t cachedMapHash = 0;
     const std::vector<StaticBoostPad>* cachedPads = nullptr;
+    BoostPadSpatialIndex cachedIndex;
+    BoostPadSoA cachedSoA;
+    GraphBuildOptions cachedGraphOptions;
+    std::vector<PadNode> cachedGraph;
+    PadRouteTable cachedRoutes;
+
+    // "(x,y) -> (x,y) -> ..." for the valid pad indices of a path
+    std::string DescribePath(const std::vector<StaticBoostPad>& pads, const std::vector<int>& path) {
+        std::string text;
+        for (int idx : path) {
+            if (idx < 0 || idx >= (int)pads.size()) continue;
+            const auto& p = pads[idx].location;
+            text += std::format("{}({},{})", text.empty() ? "" : " -> ", p.X, p.Y);
+        }
+        return text;
+    }
 }
 
 const std::vector<StaticBoostPad>& BoostPadHelper::GetCachedPads(BoostMaster* plugin) {
-    std::string mapName = plugin->gameWrapper->GetCurrentMap();
-    plugin->cvarManager->log("[BoostMaster] Current map name: " + mapName);
-    if (!cachedPads || cachedMapName != mapName) {
-        cachedMapName = mapName;
-        cachedPads = &GetStaticBoostPadsForMap(mapName);
-        plugin->cvarManager->log("[BoostMaster] Loaded " + std::to_string(cachedPads->size()) + " boost pads for this map.");
+    // The map name is only fetched and hashed once per level load
+    bool mapChanged = false;
+    if (!cachedPads || mapLoadPending) {
+        mapLoadPending = false;
+        std::string mapName = plugin->gameWrapper->GetCurrentMap();
+        uint32_t mapHash = HashMapName(mapName);
+        if (!cachedPads || mapHash != cachedMapHash) {
+            plugin->cvarManager->log("[BoostMaster] Current map name: " + mapName);
+            cachedMapHash = mapHash;
+            cachedPads = &GetStaticBoostPadsForMap(mapName);
+            cachedIndex.Build(*cachedPads);
+            cachedSoA.Build(*cachedPads);
+            mapChanged = true;
+            plugin->cvarManager->log("[BoostMaster] Loaded " + std::to_string(cachedPads->size()) + " boost pads for this map.");
+        }
+    }
+    GraphBuildOptions options = BoostSettingsWindow::GetGraphBuildOptions();
+    if (mapChanged || options != cachedGraphOptions) {
+        cachedGraphOptions = options;
+        cachedGraph = BoostPadGraph::Build(*cachedPads, options);
+        cachedRoutes = BoostPadGraph::BuildRouteTable(cachedGraph);
     }
     return *cachedPads;
 }
 
+void BoostPadHelper::OnMapLoaded() {
+    mapLoadPending = true;
+}
+
+const BoostPadSpatialIndex& BoostPadHelper::GetCachedSpatialIndex(BoostMaster* plugin) {
+    GetCachedPads(plugin);
+    return cachedIndex;
+}
+
+const BoostPadSoA& BoostPadHelper::GetCachedPadSoA(BoostMaster* plugin) {
+    GetCachedPads(plugin);
+    return cachedSoA;
+}
+
+const std::vector<PadNode>& BoostPadHelper::GetCachedGraph(BoostMaster* plugin) {
+    GetCachedPads(plugin);
+    return cachedGraph;
+}
+
+const PadRouteTable& BoostPadHelper::GetCachedRoutes(BoostMaster* plugin) {
+    GetCachedPads(plugin);
+    return cachedRoutes;
+}
+
 void BoostPadHelper::DrawAllPads(BoostMaster* plugin, std::optional<PadType> filterType) {
     if (!plugin || !plugin->gameWrapper) return;
     if (!BoostSettingsWindow::ShouldShowPads()) return;
     if (!filterType) filterType = BoostSettingsWindow::GetPadTypeFilter();
     const auto& pads = GetCachedPads(plugin);
+    int shown = 0;
     for (const auto& pad : pads) {
         if (filterType && pad.type != *filterType) continue;
-        // Ideally draw boost pad spheres or circles here; fallback to logging:
-        plugin->cvarManager->log("[BoostMaster] Pad at: (" + std::to_string(pad.location.X) + ", " + std::to_string(pad.location.Y) + ", " + std::to_string(pad.location.Z) + ") type: " + (pad.type == PadType::Big ? "Big" : "Small"));
+        // Ideally draw boost pad spheres or circles here
+        ++shown;
     }
+    LOG_THROTTLED(5.0f, "[BoostMaster] Showing {} of {} pads", shown, pads.size());
 }
 
 void BoostPadHelper::DrawPath(BoostMaster* plugin, const std::vector<int>& path) {
     if (!plugin || !plugin->gameWrapper) return;
     const auto& pads = GetCachedPads(plugin);
     if (pads.empty() || path.size() < 2) return;
-    for (size_t i = 1; i < path.size(); ++i) {
-        if (path[i - 1] < 0 || path[i - 1] >= (int)pads.size() || path[i] < 0 || path[i] >= (int)pads.size()) continue;
-        const auto& a = pads[path[i - 1]].location;
-        const auto& b = pads[path[i]].location;
-        plugin->cvarManager->log("[BoostMaster] Path segment: (" + std::to_string(a.X) + "," + std::to_string(a.Y) + ") -> (" + std::to_string(b.X) + "," + std::to_string(b.Y) + ")");
-    }
+
+    // Only describe a path when it differs from the last one printed; the
+    // description is built only then
+    uint64_t pathKey = 1469598103934665603ull;
+    for (int idx : path) pathKey = (pathKey ^ static_cast<uint32_t>(idx)) * 1099511628211ull;
+    LOG_ON_CHANGE(pathKey, "[BoostMaster] Path: {}", DescribePath(pads, path));
 }
 
 void BoostPadHelper::DrawPathOverlay(BoostMaster* plugin) {
@@ -58,7 +116,7 @@ void BoostPadHelper::DrawPathOverlay(BoostMaster* plugin) {
     // The actual drawing is done in DrawPathOverlayCanvas
 }
 
-void BoostPadHelper::DrawPathOverlayCanvas(BoostMaster* plugin, CanvasWrapper canvas, const std::vector<int>& path) {
+void BoostPadHelper::DrawPathOverlayCanvas(BoostMaster* plugin, CanvasWrapper canvas, std::span<const int> path, LinearColor color) {
     if (!plugin || !plugin->gameWrapper) return;
     const auto& pads = GetCachedPads(plugin);
     if (pads.empty() || path.size() < 2) return;
@@ -73,7 +131,7 @@ void BoostPadHelper::DrawPathOverlayCanvas(BoostMaster* plugin, CanvasWrapper ca
     if (screenPoints.size() < 2) return;
 
     float thickness = BoostSettingsWindow::GetOverlaySize();
-    canvas.SetColor(LinearColor{0.0f, 1.0f, 0.0f, 1.0f}); // Green color
+    canvas.SetColor(color);
     for (size_t i = 1; i < screenPoints.size(); ++i) {
         canvas.DrawLine(screenPoints[i - 1], screenPoints[i], thickness);
     }
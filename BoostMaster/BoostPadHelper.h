@@ -1,9 +1,13 @@
 #pragma once
 
 #include "BoostPadData.h"
+#include "BoostPadGraph.h"
+#include "BoostPadSpatialIndex.h"
+#include "BoostPadSoA.h"
 #include "bakkesmod/wrappers/CanvasWrapper.h"
 #include <vector>
 #include <optional>
+#include <span>
 
 // Forward declaration to avoid circular dependency
 class BoostMaster;
@@ -13,6 +17,21 @@ public:
     // Returns cached pads for the current map
     static const std::vector<StaticBoostPad>& GetCachedPads(BoostMaster* plugin);
 
+    // Called on level load; the next GetCachedPads re-reads and hashes the map name
+    static void OnMapLoaded();
+
+    // Returns the nearest-pad lookup grid for the current map, rebuilt with the cached pads
+    static const BoostPadSpatialIndex& GetCachedSpatialIndex(BoostMaster* plugin);
+
+    // Returns the SIMD-friendly coordinate mirror of the cached pads
+    static const BoostPadSoA& GetCachedPadSoA(BoostMaster* plugin);
+
+    // Returns the pad graph for the current map, rebuilt with the cached pads
+    static const std::vector<PadNode>& GetCachedGraph(BoostMaster* plugin);
+
+    // Returns the all-pairs route table for the current map, rebuilt with the cached pads
+    static const PadRouteTable& GetCachedRoutes(BoostMaster* plugin);
+
     // Draw all pads, optionally filtering by type
     static void DrawAllPads(BoostMaster* plugin, std::optional<PadType> filterType = std::nullopt);
 
@@ -23,5 +42,6 @@ public:
     static void DrawPathOverlay(BoostMaster* plugin);
 
     // Draw a path overlay on the HUD (2D screen lines) using CanvasWrapper
-    static void DrawPathOverlayCanvas(BoostMaster* plugin, CanvasWrapper canvas, const std::vector<int>& path);
+    static void DrawPathOverlayCanvas(BoostMaster* plugin, CanvasWrapper canvas, std::span<const int> path,
+        LinearColor color = LinearColor{0.0f, 1.0f, 0.0f, 1.0f});
 };
@@ -0,0 +1,103 @@
+#include "pch.h"
+#include "BoostPadRouter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+    // Cars rarely hold less than this between pads; keeps ETAs sane from standstill
+    constexpr float kMinCruiseSpeed = 1000.0f;
+    constexpr float kMaxSpeed = 2300.0f;
+    constexpr float kMaxBoost = 100.0f;
+    // Added to travel time so a pad right under the car doesn't score as infinite
+    constexpr float kTimeBias = 0.25f;
+
+    float dist(const Vector& a, const Vector& b) {
+        float dx = a.X - b.X, dy = a.Y - b.Y, dz = a.Z - b.Z;
+        return std::sqrt(dx*dx + dy*dy + dz*dz);
+    }
+
+    struct SearchState {
+        const std::vector<PadNode>& graph;
+        const BoostRouteQuery& query;
+        float speed = kMinCruiseSpeed;
+        int maxStops = 1;
+        int stack[kMaxRouteStops] = {};
+        BoostRoute best;
+        float bestScore = 0.0f;
+        int expansions = 0;
+        int limit = 0;          // expansion count at which the current subtree stops
+        bool truncated = false; // some subtree hit its limit this pass
+    };
+
+    bool PadUpAt(const SearchState& s, int pad, float arrival) {
+        return !s.query.padRespawnAt || s.query.padRespawnAt[pad] <= arrival;
+    }
+
+    void Visit(SearchState& s, int pad, int depth, uint64_t visited, float time, float boost, float gained) {
+        if (s.expansions >= s.limit) {
+            s.truncated = true;
+            return;
+        }
+        ++s.expansions;
+        s.stack[depth] = pad;
+
+        float score = gained / (time + kTimeBias);
+        if (score > s.bestScore) {
+            s.bestScore = score;
+            s.best.count = depth + 1;
+            std::copy(s.stack, s.stack + depth + 1, s.best.pads);
+            s.best.boostGained = gained;
+            s.best.travelTime = time;
+        }
+        if (depth + 1 >= s.maxStops || boost >= kMaxBoost) return;
+
+        const PadNode& node = s.graph[pad];
+        for (int next : node.neighbors) {
+            if (next >= kMaxBoostPads || (visited & (uint64_t(1) << next))) continue;
+            float t = time + dist(node.pad->location, s.graph[next].pad->location) / s.speed;
+            if (!PadUpAt(s, next, s.query.now + t)) continue;
+            float gain = std::min(s.graph[next].pad->amount, kMaxBoost - boost);
+            Visit(s, next, depth + 1, visited | (uint64_t(1) << next), t, boost + gain, gained + gain);
+            if (s.expansions >= s.limit) return;
+        }
+    }
+}
+
+BoostRoute BoostPadRouter::FindBestRoute(const std::vector<PadNode>& graph, const BoostRouteQuery& query) {
+    SearchState s{ graph, query, kMinCruiseSpeed, 1, {}, {} };
+    s.speed = std::clamp(query.carSpeed, kMinCruiseSpeed, kMaxSpeed);
+
+    const int n = std::min(static_cast<int>(graph.size()), kMaxBoostPads);
+    if (n == 0 || query.carBoost >= kMaxBoost) return s.best;
+
+    // First stop: the nearest pads to the car that will be up on arrival
+    std::pair<float, int> first[kMaxBoostPads];
+    int firstCount = 0;
+    for (int i = 0; i < n; ++i) {
+        float t = dist(query.carLocation, graph[i].pad->location) / s.speed;
+        if (PadUpAt(s, i, query.now + t)) first[firstCount++] = { t, i };
+    }
+    int take = std::min(std::max(query.firstHopCandidates, 1), firstCount);
+    std::partial_sort(first, first + take, first + firstCount);
+
+    // Iterative deepening: every first hop is scored as a one-stop route, then every
+    // two-stop route, and so on, so the budget running out can only cut the deepest
+    // level. Within a level each remaining first hop gets an equal share of what is
+    // left, so one large subtree cannot starve the others.
+    const int budget = std::max(query.expansionBudget, take);
+    const int deepest = std::clamp(query.maxStops, 1, kMaxRouteStops);
+    for (int stops = 1; stops <= deepest && s.expansions < budget; ++stops) {
+        s.maxStops = stops;
+        s.truncated = false;
+        for (int c = 0; c < take; ++c) {
+            auto [t, pad] = first[c];
+            s.limit = s.expansions + std::max(1, (budget - s.expansions) / (take - c));
+            float gain = std::min(graph[pad].pad->amount, kMaxBoost - query.carBoost);
+            Visit(s, pad, 0, uint64_t(1) << pad, t, query.carBoost + gain, gain);
+        }
+        if (s.truncated) break;
+    }
+    s.best.expansions = s.expansions;
+    return s.best;
+}
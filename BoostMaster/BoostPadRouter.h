@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include "bakkesmod/wrappers/WrapperStructs.h"
+#include "BoostPadData.h"
+#include "BoostPadGraph.h"
+
+constexpr int kMaxRouteStops = 6;
+
+// Live inputs for a route query. Respawn deadlines are absolute times on the
+// same clock as `now`; a pad is usable once now + travel time reaches them.
+struct BoostRouteQuery {
+    Vector carLocation;
+    float carSpeed = 0.0f;                 // uu/s, raised to a cruise floor for timing
+    float carBoost = 0.0f;                 // current boost, 0-100
+    float now = 0.0f;
+    const float* padRespawnAt = nullptr;   // one deadline per pad, nullptr = all pads up
+    int maxStops = 4;                      // clamped to kMaxRouteStops
+    int firstHopCandidates = 6;            // nearest pads considered as the first stop
+    int expansionBudget = 2048;            // cap on search nodes per query, across all depths
+};
+
+struct BoostRoute {
+    int pads[kMaxRouteStops] = {};
+    int count = 0;
+    float boostGained = 0.0f;
+    float travelTime = 0.0f;
+    int expansions = 0;
+
+    bool Empty() const { return count == 0; }
+    float BoostPerSecond() const { return travelTime > 0.0f ? boostGained / travelTime : 0.0f; }
+};
+
+class BoostPadRouter {
+public:
+    // Iterative-deepening search from the car over graph neighbours that maximises
+    // boost collected per second of travel. Each route length is searched in full
+    // before the next; when the budget runs out only the longest length is partial.
+    // Pads still on cooldown at arrival are pruned, boost above 100 is not counted,
+    // and the search never allocates.
+    static BoostRoute FindBestRoute(const std::vector<PadNode>& graph, const BoostRouteQuery& query);
+};
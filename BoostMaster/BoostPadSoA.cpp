@@ -0,0 +1,147 @@
+#include "pch.h"
+#include "BoostPadSoA.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BOOSTMASTER_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BOOSTMASTER_SSE2 1
+#endif
+
+namespace {
+    // Squares to ~1e30, still finite in float, and never wins a nearest search
+    constexpr float kSentinel = 1.0e15f;
+
+    void DistancesKernel(const float* x, const float* y, const float* z, int padded,
+        float qx, float qy, float qz, float* out) {
+#if defined(BOOSTMASTER_AVX2)
+        const __m256 vx = _mm256_set1_ps(qx), vy = _mm256_set1_ps(qy), vz = _mm256_set1_ps(qz);
+        for (int i = 0; i < padded; i += 8) {
+            __m256 dx = _mm256_sub_ps(_mm256_load_ps(x + i), vx);
+            __m256 dy = _mm256_sub_ps(_mm256_load_ps(y + i), vy);
+            __m256 dz = _mm256_sub_ps(_mm256_load_ps(z + i), vz);
+            __m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dz, dz)));
+            _mm256_storeu_ps(out + i, d);
+        }
+#elif defined(BOOSTMASTER_SSE2)
+        const __m128 vx = _mm_set1_ps(qx), vy = _mm_set1_ps(qy), vz = _mm_set1_ps(qz);
+        for (int i = 0; i < padded; i += 4) {
+            __m128 dx = _mm_sub_ps(_mm_load_ps(x + i), vx);
+            __m128 dy = _mm_sub_ps(_mm_load_ps(y + i), vy);
+            __m128 dz = _mm_sub_ps(_mm_load_ps(z + i), vz);
+            __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_add_ps(_mm_mul_ps(dy, dy), _mm_mul_ps(dz, dz)));
+            _mm_storeu_ps(out + i, d);
+        }
+#else
+        for (int i = 0; i < padded; ++i) {
+            float dx = x[i] - qx, dy = y[i] - qy, dz = z[i] - qz;
+            out[i] = dx*dx + dy*dy + dz*dz;
+        }
+#endif
+    }
+
+    // Four queries per pass: each block of pad coordinates is loaded once and reused
+    // for all four, so a query costs its arithmetic but not its own pad loads. Rows
+    // of out are `padded` floats apart.
+    constexpr int kQueryBlock = 4;
+
+    void DistancesKernel4(const float* x, const float* y, const float* z, int padded,
+        const Vector* q, float* out) {
+#if defined(BOOSTMASTER_AVX2)
+        __m256 qx[kQueryBlock], qy[kQueryBlock], qz[kQueryBlock];
+        for (int k = 0; k < kQueryBlock; ++k) {
+            qx[k] = _mm256_set1_ps(q[k].X);
+            qy[k] = _mm256_set1_ps(q[k].Y);
+            qz[k] = _mm256_set1_ps(q[k].Z);
+        }
+        for (int i = 0; i < padded; i += 8) {
+            const __m256 px = _mm256_load_ps(x + i), py = _mm256_load_ps(y + i), pz = _mm256_load_ps(z + i);
+            for (int k = 0; k < kQueryBlock; ++k) {
+                __m256 dx = _mm256_sub_ps(px, qx[k]);
+                __m256 dy = _mm256_sub_ps(py, qy[k]);
+                __m256 dz = _mm256_sub_ps(pz, qz[k]);
+                __m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_add_ps(_mm256_mul_ps(dy, dy), _mm256_mul_ps(dz, dz)));
+                _mm256_storeu_ps(out + static_cast<size_t>(k) * padded + i, d);
+            }
+        }
+#elif defined(BOOSTMASTER_SSE2)
+        __m128 qx[kQueryBlock], qy[kQueryBlock], qz[kQueryBlock];
+        for (int k = 0; k < kQueryBlock; ++k) {
+            qx[k] = _mm_set1_ps(q[k].X);
+            qy[k] = _mm_set1_ps(q[k].Y);
+            qz[k] = _mm_set1_ps(q[k].Z);
+        }
+        for (int i = 0; i < padded; i += 4) {
+            const __m128 px = _mm_load_ps(x + i), py = _mm_load_ps(y + i), pz = _mm_load_ps(z + i);
+            for (int k = 0; k < kQueryBlock; ++k) {
+                __m128 dx = _mm_sub_ps(px, qx[k]);
+                __m128 dy = _mm_sub_ps(py, qy[k]);
+                __m128 dz = _mm_sub_ps(pz, qz[k]);
+                __m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_add_ps(_mm_mul_ps(dy, dy), _mm_mul_ps(dz, dz)));
+                _mm_storeu_ps(out + static_cast<size_t>(k) * padded + i, d);
+            }
+        }
+#else
+        for (int i = 0; i < padded; ++i) {
+            for (int k = 0; k < kQueryBlock; ++k) {
+                float dx = x[i] - q[k].X, dy = y[i] - q[k].Y, dz = z[i] - q[k].Z;
+                out[static_cast<size_t>(k) * padded + i] = dx*dx + dy*dy + dz*dz;
+            }
+        }
+#endif
+    }
+}
+
+void BoostPadSoA::Build(const std::vector<StaticBoostPad>& pads) {
+    Build(static_cast<int>(pads.size()), [&](int i) { return pads[i].location; });
+}
+
+void BoostPadSoA::Build(std::span<const Vector> locations) {
+    Build(static_cast<int>(locations.size()), [&](int i) { return locations[i]; });
+}
+
+template <typename LocationAt>
+void BoostPadSoA::Build(int padCount, LocationAt locationAt) {
+    count = std::min(padCount, kMaxBoostPads);
+    padded = (count + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+    for (int i = 0; i < kMaxBoostPads; ++i) {
+        bool real = i < count;
+        Vector location = real ? locationAt(i) : Vector(kSentinel, kSentinel, kSentinel);
+        x[i] = location.X;
+        y[i] = location.Y;
+        z[i] = location.Z;
+    }
+}
+
+void BoostPadSoA::SquaredDistances(const Vector& q, float* out) const {
+    DistancesKernel(x, y, z, padded, q.X, q.Y, q.Z, out);
+}
+
+void BoostPadSoA::SquaredDistances(const Vector* queries, int queryCount, float* out) const {
+    int k = 0;
+    for (; k + kQueryBlock <= queryCount; k += kQueryBlock) {
+        DistancesKernel4(x, y, z, padded, queries + k, out + static_cast<size_t>(k) * padded);
+    }
+    for (; k < queryCount; ++k) {
+        DistancesKernel(x, y, z, padded, queries[k].X, queries[k].Y, queries[k].Z, out + static_cast<size_t>(k) * padded);
+    }
+}
+
+int BoostPadSoA::Nearest(const Vector& q, uint64_t excludeMask, float* outDistSq) const {
+    alignas(32) float d[kMaxBoostPads];
+    SquaredDistances(q, d);
+    int best = -1;
+    float bestDist = std::numeric_limits<float>::max();
+    for (int i = 0; i < count; ++i) {
+        if (excludeMask & (uint64_t(1) << i)) continue;
+        if (d[i] < bestDist) {
+            bestDist = d[i];
+            best = i;
+        }
+    }
+    if (outDistSq) *outDistSq = bestDist;
+    return best;
+}
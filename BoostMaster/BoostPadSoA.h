@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstdint>
+#include "bakkesmod/wrappers/WrapperStructs.h"
+#include "BoostPadData.h"
+
+// Structure-of-arrays mirror of a pad layout for batched distance math. Coordinates
+// live in 32-byte aligned X/Y/Z arrays sized for kMaxBoostPads (a multiple of the
+// SIMD width); slots past Count() hold far-away sentinels so kernels can run over
+// whole vectors without tail handling.
+class BoostPadSoA {
+public:
+    static constexpr int kSimdWidth = 8;
+
+    void Build(const std::vector<StaticBoostPad>& pads);
+    // Same from bare locations, e.g. the pads of a graph
+    void Build(std::span<const Vector> locations);
+    int Count() const { return count; }
+    // Count rounded up to kSimdWidth; output buffers must hold this many floats per query
+    int PaddedCount() const { return padded; }
+
+    // Squared distance from q to every pad, written to out[0..PaddedCount())
+    void SquaredDistances(const Vector& q, float* out) const;
+    // Same for several query points; out holds queryCount rows of PaddedCount() floats.
+    // Queries are taken four at a time so each pad block is loaded once per four.
+    void SquaredDistances(const Vector* queries, int queryCount, float* out) const;
+    // Nearest pad to q that is not in excludeMask (bit i = pad i); -1 if none
+    int Nearest(const Vector& q, uint64_t excludeMask = 0, float* outDistSq = nullptr) const;
+
+private:
+    template <typename LocationAt>
+    void Build(int padCount, LocationAt locationAt);
+
+    int count = 0;
+    int padded = 0;
+    alignas(32) float x[kMaxBoostPads] = {};
+    alignas(32) float y[kMaxBoostPads] = {};
+    alignas(32) float z[kMaxBoostPads] = {};
+};
@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "BoostPadSpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+    // Soccar field half-extents, goals included; other arenas fit inside
+    constexpr float kFieldHalfX = 4096.0f;
+    constexpr float kFieldHalfY = 6000.0f;
+
+    float distSq2D(const Vector& a, float x, float y) {
+        float dx = a.X - x, dy = a.Y - y;
+        return dx*dx + dy*dy;
+    }
+}
+
+void BoostPadSpatialIndex::Build(const std::vector<StaticBoostPad>& layout) {
+    pads = &layout;
+    padCount = std::min(static_cast<int>(layout.size()), kMaxBoostPads);
+    cellStart.clear();
+    candidates.clear();
+    if (padCount == 0) return;
+
+    minX = -kFieldHalfX;
+    minY = -kFieldHalfY;
+    width = static_cast<int>(2.0f * kFieldHalfX / kCellSize);
+    height = static_cast<int>(2.0f * kFieldHalfY / kCellSize);
+    cellStart.reserve(static_cast<size_t>(width) * height + 1);
+    candidates.reserve(static_cast<size_t>(width) * height * kCandidates);
+
+    // For a point p in a cell with centre c and half-diagonal h, the nearest pad q
+    // satisfies |pq| <= |p q0| <= d0 + h, where q0 is the pad nearest c at distance
+    // d0, so |cq| <= d0 + 2h. Listing every pad within that bound (plus a little
+    // slack for float rounding) makes each cell's list complete.
+    const float halfDiagonal = 0.5f * kCellSize * 1.41421356f;
+    const int minTake = std::min(kCandidates, padCount);
+    std::pair<float, int> byDist[kMaxBoostPads];
+    for (int cy = 0; cy < height; ++cy) {
+        float y = minY + (cy + 0.5f) * kCellSize;
+        for (int cx = 0; cx < width; ++cx) {
+            float x = minX + (cx + 0.5f) * kCellSize;
+            for (int i = 0; i < padCount; ++i) byDist[i] = { distSq2D(layout[i].location, x, y), i };
+            std::sort(byDist, byDist + padCount);
+
+            float reach = std::sqrt(byDist[0].first) + 2.0f * halfDiagonal + 1.0f;
+            float reachSq = reach * reach;
+            cellStart.push_back(static_cast<uint32_t>(candidates.size()));
+            for (int k = 0; k < padCount && (k < minTake || byDist[k].first <= reachSq); ++k) {
+                candidates.push_back(static_cast<uint8_t>(byDist[k].second));
+            }
+        }
+    }
+    cellStart.push_back(static_cast<uint32_t>(candidates.size()));
+}
+
+int BoostPadSpatialIndex::CellIndex(const Vector& loc) const {
+    float fx = (loc.X - minX) / kCellSize;
+    float fy = (loc.Y - minY) / kCellSize;
+    if (!(fx >= 0.0f && fx < width && fy >= 0.0f && fy < height)) return -1;
+    int cx = std::min(static_cast<int>(fx), width - 1);
+    int cy = std::min(static_cast<int>(fy), height - 1);
+    return cy * width + cx;
+}
+
+int BoostPadSpatialIndex::Nearest(const Vector& loc) const {
+    if (padCount == 0) return -1;
+
+    // Inside the grid the cell's list holds the nearest pad (see Build); outside it,
+    // which play never reaches, every pad is checked
+    const uint8_t* first = nullptr;
+    const uint8_t* last = nullptr;
+    int cell = CellIndex(loc);
+    if (cell >= 0) {
+        first = candidates.data() + cellStart[cell];
+        last = candidates.data() + cellStart[cell + 1];
+    }
+
+    int best = -1;
+    float bestDist = 0.0f;
+    auto consider = [&](int pad) {
+        float d = distSq2D((*pads)[pad].location, loc.X, loc.Y);
+        if (best < 0 || d < bestDist) {
+            bestDist = d;
+            best = pad;
+        }
+    };
+    if (first) {
+        for (const uint8_t* it = first; it != last; ++it) consider(*it);
+    }
+    else {
+        for (int i = 0; i < padCount; ++i) consider(i);
+    }
+    return best;
+}
+
+int BoostPadSpatialIndex::KNearest(const Vector& loc, int* out, int maxCount) const {
+    if (padCount == 0 || !out) return 0;
+    int cell = CellIndex(loc);
+    if (cell < 0) {
+        // Outside the grid: use the nearest edge cell's list, as a hint
+        int cx = std::clamp(static_cast<int>((loc.X - minX) / kCellSize), 0, width - 1);
+        int cy = std::clamp(static_cast<int>((loc.Y - minY) / kCellSize), 0, height - 1);
+        cell = cy * width + cx;
+    }
+    int count = 0;
+    for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1] && count < maxCount; ++k) out[count++] = candidates[k];
+    return count;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "bakkesmod/wrappers/WrapperStructs.h"
+#include "BoostPadData.h"
+
+// Uniform 2D grid over the field where every cell stores, closest to its centre
+// first, every pad that can be nearest to some point in the cell: a rasterised
+// Voronoi diagram of the layout. Lookups inside the grid are one cell read and a
+// few distance checks, and always exact; points outside it scan every pad.
+class BoostPadSpatialIndex {
+public:
+    // Every cell lists at least this many pads, for KNearest
+    static constexpr int kCandidates = 4;
+    static constexpr float kCellSize = 128.0f;
+
+    void Build(const std::vector<StaticBoostPad>& pads);
+    bool Empty() const { return padCount == 0; }
+
+    // Nearest pad to loc in the XY plane, -1 if the layout has no pads
+    int Nearest(const Vector& loc) const;
+    // Pads nearest the centre of the cell containing loc (the nearest edge cell outside
+    // the grid), closest first; returns how many were written
+    int KNearest(const Vector& loc, int* out, int maxCount) const;
+
+private:
+    // Cell containing loc, or -1 outside the grid
+    int CellIndex(const Vector& loc) const;
+
+    const std::vector<StaticBoostPad>* pads = nullptr;
+    int padCount = 0;
+    int width = 0;
+    int height = 0;
+    float minX = 0.0f;
+    float minY = 0.0f;
+    std::vector<uint32_t> cellStart; // cell i's candidates are candidates[cellStart[i], cellStart[i + 1])
+    std::vector<uint8_t> candidates;
+};
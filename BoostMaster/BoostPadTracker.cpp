@@ -0,0 +1,40 @@
+#include "pch.h"
+#include "BoostPadTracker.h"
+#include <algorithm>
+
+namespace {
+    // Pickup radii are ~210uu (big) and ~145uu (small); allow for a tick of travel
+    constexpr float kMaxPickupDistance = 500.0f;
+}
+
+void BoostPadTracker::Sync(const std::vector<StaticBoostPad>& pads) {
+    if (layout == &pads) return;
+    layout = &pads;
+    padCount = std::min(static_cast<int>(pads.size()), kMaxBoostPads);
+    Reset();
+}
+
+void BoostPadTracker::Reset() {
+    takenMask = 0;
+    std::fill(std::begin(respawnAt), std::end(respawnAt), 0.0f);
+}
+
+int BoostPadTracker::OnPickup(const BoostPadSpatialIndex& index, const Vector& carLocation, float now) {
+    if (!layout) return -1;
+
+    int pad = index.Nearest(carLocation);
+    if (pad < 0 || pad >= padCount) return -1;
+    const Vector& p = (*layout)[pad].location;
+    float dx = p.X - carLocation.X, dy = p.Y - carLocation.Y, dz = p.Z - carLocation.Z;
+    if (dx*dx + dy*dy + dz*dz > kMaxPickupDistance * kMaxPickupDistance) return -1;
+
+    MarkTaken(pad, now);
+    return pad;
+}
+
+void BoostPadTracker::MarkTaken(int pad, float now) {
+    if (!layout || pad < 0 || pad >= padCount) return;
+    float delay = (*layout)[pad].type == PadType::Big ? kBigPadRespawnTime : kSmallPadRespawnTime;
+    takenMask |= uint64_t(1) << pad;
+    respawnAt[pad] = now + delay;
+}
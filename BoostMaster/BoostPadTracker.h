@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "bakkesmod/wrappers/WrapperStructs.h"
+#include "BoostPadData.h"
+#include "BoostPadSpatialIndex.h"
+
+// Live availability of the pads returned by BoostPadHelper::GetCachedPads, indexed
+// the same way. A bit per pad marks it taken and a deadline array holds when it
+// comes back; deadlines are 0 for pads that are up. Everything runs on the game
+// thread, so queries are plain reads and cheap enough to call every frame.
+class BoostPadTracker {
+public:
+    // Reset to all-up when the pad layout changes; no-op for the same layout
+    void Sync(const std::vector<StaticBoostPad>& pads);
+    void Reset();
+
+    // Attribute a pickup to the pad nearest the car; returns the pad index or -1
+    int OnPickup(const BoostPadSpatialIndex& index, const Vector& carLocation, float now);
+    void MarkTaken(int pad, float now);
+
+    bool IsUp(int pad, float now) const {
+        if (pad < 0 || pad >= padCount) return true;
+        return !(takenMask & (uint64_t(1) << pad)) || now >= respawnAt[pad];
+    }
+    float TimeUntilRespawn(int pad, float now) const {
+        return IsUp(pad, now) ? 0.0f : respawnAt[pad] - now;
+    }
+    // Bit i set while pad i is respawning
+    uint64_t DownMask(float now) const {
+        uint64_t mask = 0;
+        for (int i = 0; i < padCount; ++i) {
+            if (now < respawnAt[i]) mask |= uint64_t(1) << i;
+        }
+        return mask & takenMask;
+    }
+    // Per-pad respawn deadlines, suitable for BoostRouteQuery::padRespawnAt
+    const float* RespawnDeadlines() const { return respawnAt; }
+    int PadCount() const { return padCount; }
+
+private:
+    const std::vector<StaticBoostPad>* layout = nullptr;
+    int padCount = 0;
+    uint64_t takenMask = 0;
+    float respawnAt[kMaxBoostPads] = {};
+};
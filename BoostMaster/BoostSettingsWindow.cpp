@@ -3,6 +3,7 @@
 #include "BoostMaster.h"
 #include "imgui/imgui.h"
 #include "BoostPadData.h"
+#include "BoostPadGraph.h"
 #include <vector>
 #include <string>
 #include <fstream>
@@ -11,24 +12,29 @@
 
 // Settings for pad visualization
 static bool showPads = true;
+static bool showCoachRoute = true;
 static int padTypeFilter = -1; // -1 = all, 0 = big, 1 = small
 static float overlayColor[4] = {1.0f, 1.0f, 0.0f, 1.0f}; // Default yellow
 static float overlaySize = 1.0f;
 extern int pathAlgo; // 0 = Dijkstra, 1 = A*
+static int graphMode = 0; // 0 = fully connected, 1 = k-nearest
+static int graphNeighbors = 4;
+static float graphDetourRatio = 1.15f;
+static float graphMaxEdge = 0.0f; // 0 = no limit
 static char errorLogPath[256] = "error.log";
 
-void ExportHistory(const std::vector<float>& history) {
+void ExportHistory(const PlotSeries& history) {
     std::filesystem::create_directories("data");
     std::ofstream out("data/boost_history_export.csv");
-    for (float v : history) out << v << "\n";
+    for (float v : history.Values()) out << v << "\n";
 }
 
-void ImportHistory(std::vector<float>& history) {
+void ImportHistory(PlotSeries& history) {
     std::ifstream in("data/boost_history_export.csv");
     if (!in) return;
     std::string line;
     while (std::getline(in, line)) {
-        try { history.push_back(std::stof(line)); } catch (...) {}
+        try { history.Push(std::stof(line)); } catch (...) {}
     }
 }
 
@@ -52,6 +58,7 @@ void BoostSettingsWindow::Render() {
     }
     ImGui::Separator();
     ImGui::Checkbox("Show Boost Pads", &showPads);
+    ImGui::Checkbox("Show Coaching Route", &showCoachRoute);
     ImGui::Text("Pad Type Filter:");
     ImGui::RadioButton("All", &padTypeFilter, -1); ImGui::SameLine();
     ImGui::RadioButton("Big", &padTypeFilter, 0); ImGui::SameLine();
@@ -65,6 +72,14 @@ void BoostSettingsWindow::Render() {
     ImGui::Text("Pathfinding Algorithm:");
     ImGui::RadioButton("Dijkstra", &pathAlgo, 0); ImGui::SameLine();
     ImGui::RadioButton("A* (WIP)", &pathAlgo, 1);
+    ImGui::Text("Pad Graph:");
+    ImGui::RadioButton("Fully Connected", &graphMode, 0); ImGui::SameLine();
+    ImGui::RadioButton("K-Nearest", &graphMode, 1);
+    if (graphMode == 1) {
+        ImGui::SliderInt("Neighbors (k)", &graphNeighbors, 1, 12);
+        ImGui::SliderFloat("Detour Pruning", &graphDetourRatio, 0.0f, 1.5f, graphDetourRatio < 1.0f ? "off" : "%.2f");
+        ImGui::SliderFloat("Max Edge Length", &graphMaxEdge, 0.0f, 10000.0f, graphMaxEdge <= 0.0f ? "unlimited" : "%.0f");
+    }
     ImGui::Separator();
     if (ImGui::Button("Export History")) ExportHistory(plugin->historyLog);
     ImGui::SameLine();
@@ -77,6 +92,7 @@ void BoostSettingsWindow::Render() {
 
 // Accessors for use in BoostPadHelper
 bool BoostSettingsWindow::ShouldShowPads() { return showPads; }
+bool BoostSettingsWindow::ShouldShowCoachRoute() { return showCoachRoute; }
 std::optional<PadType> BoostSettingsWindow::GetPadTypeFilter() {
     if (padTypeFilter == 0) return PadType::Big;
     if (padTypeFilter == 1) return PadType::Small;
@@ -88,3 +104,12 @@ float BoostSettingsWindow::GetOverlaySize() { return overlaySize; }
 void BoostSettingsWindow::ToggleShowPads() {
     showPads = !showPads;
 }
+
+GraphBuildOptions BoostSettingsWindow::GetGraphBuildOptions() {
+    GraphBuildOptions options;
+    options.mode = graphMode == 1 ? GraphBuildMode::NearestNeighbors : GraphBuildMode::FullyConnected;
+    options.neighborCount = graphNeighbors;
+    options.detourRatio = graphDetourRatio < 1.0f ? 0.0f : graphDetourRatio;
+    options.maxEdgeLength = graphMaxEdge;
+    return options;
+}
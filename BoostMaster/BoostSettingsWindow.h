@@ -6,6 +6,7 @@
 // Forward declarations
 class BoostMaster;
 enum class PadType;
+struct GraphBuildOptions;
 
 class BoostSettingsWindow : public GuiBase {
 public:
@@ -14,10 +15,12 @@ public:
 
     // Static methods for accessing settings
     static bool ShouldShowPads();
+    static bool ShouldShowCoachRoute();
     static std::optional<PadType> GetPadTypeFilter();
     static const float* GetOverlayColor();
     static float GetOverlaySize();
     static void ToggleShowPads();
+    static GraphBuildOptions GetGraphBuildOptions();
 
 private:
     BoostMaster* plugin;
@@ -0,0 +1,117 @@
+#include "pch.h"
+#include "HeatmapDensity.h"
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BOOSTMASTER_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BOOSTMASTER_SSE2 1
+#endif
+
+namespace {
+    // out[i] = sum over k of taps[k] * in[i + k], for i in [0, count)
+    void ConvolveRow(const float* in, const float* taps, int tapCount, int count, float* out) {
+        int i = 0;
+#if defined(BOOSTMASTER_AVX2)
+        for (; i + 8 <= count; i += 8) {
+            __m256 acc = _mm256_setzero_ps();
+            for (int k = 0; k < tapCount; ++k) {
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_set1_ps(taps[k]), _mm256_loadu_ps(in + i + k)));
+            }
+            _mm256_storeu_ps(out + i, acc);
+        }
+#elif defined(BOOSTMASTER_SSE2)
+        for (; i + 4 <= count; i += 4) {
+            __m128 acc = _mm_setzero_ps();
+            for (int k = 0; k < tapCount; ++k) {
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(taps[k]), _mm_loadu_ps(in + i + k)));
+            }
+            _mm_storeu_ps(out + i, acc);
+        }
+#endif
+        for (; i < count; ++i) {
+            float acc = 0.0f;
+            for (int k = 0; k < tapCount; ++k) acc += taps[k] * in[i + k];
+            out[i] = acc;
+        }
+    }
+
+    // out[i] += weight * in[i], for i in [0, count)
+    void AccumulateRow(const float* in, float weight, int count, float* out) {
+        int i = 0;
+#if defined(BOOSTMASTER_AVX2)
+        const __m256 w = _mm256_set1_ps(weight);
+        for (; i + 8 <= count; i += 8) {
+            _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(w, _mm256_loadu_ps(in + i))));
+        }
+#elif defined(BOOSTMASTER_SSE2)
+        const __m128 w = _mm_set1_ps(weight);
+        for (; i + 4 <= count; i += 4) {
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(w, _mm_loadu_ps(in + i))));
+        }
+#endif
+        for (; i < count; ++i) out[i] += weight * in[i];
+    }
+}
+
+void SplatKernel::Build(float sigmaCells) {
+    sigma = std::min(std::max(sigmaCells, 0.0f), kMaxRadius / 3.0f);
+    radius = sigma > 0.0f ? std::clamp((int)std::ceil(3.0f * sigma), 1, kMaxRadius) : 0;
+
+    for (int phase = 0; phase < kPhases; ++phase) {
+        // Sample offset inside its cell, measured from the cell's low edge
+        const float offset = (phase + 0.5f) / kPhases;
+        float* w = weights[phase];
+        float sum = 0.0f;
+        for (int k = -radius; k <= radius; ++k) {
+            float d = k + 0.5f - offset;
+            w[k + radius] = sigma > 0.0f ? std::exp(-d * d / (2.0f * sigma * sigma)) : 1.0f;
+            sum += w[k + radius];
+        }
+        for (int k = 0; k <= 2 * radius; ++k) w[k] /= sum;
+    }
+}
+
+std::vector<float> Density::GaussianTaps(float sigmaCells) {
+    if (sigmaCells <= 0.0f) return { 1.0f };
+    const int radius = std::max(1, (int)std::ceil(3.0f * sigmaCells));
+    std::vector<float> taps(2 * radius + 1);
+    float sum = 0.0f;
+    for (int k = -radius; k <= radius; ++k) {
+        taps[k + radius] = std::exp(-(float)(k * k) / (2.0f * sigmaCells * sigmaCells));
+        sum += taps[k + radius];
+    }
+    for (float& tap : taps) tap /= sum;
+    return taps;
+}
+
+void Density::GaussianBlur(float* grid, int width, int height, float sigmaCells, std::vector<float>& scratch) {
+    if (sigmaCells <= 0.0f || width <= 0 || height <= 0) return;
+    const std::vector<float> taps = GaussianTaps(sigmaCells);
+    const int tapCount = (int)taps.size();
+    const int radius = tapCount / 2;
+
+    // A zero-padded copy of one row, then the horizontally blurred grid
+    const size_t lineSize = (size_t)width + 2 * radius;
+    scratch.assign(lineSize + (size_t)width * height, 0.0f);
+    float* line = scratch.data();
+    float* rows = line + lineSize;
+
+    for (int y = 0; y < height; ++y) {
+        std::copy(grid + (size_t)y * width, grid + (size_t)(y + 1) * width, line + radius);
+        ConvolveRow(line, taps.data(), tapCount, width, rows + (size_t)y * width);
+    }
+
+    // Vertically, each output row is a weighted sum of whole rows, so this pass
+    // also runs along contiguous memory
+    for (int y = 0; y < height; ++y) {
+        float* out = grid + (size_t)y * width;
+        std::fill(out, out + width, 0.0f);
+        const int k0 = std::max(0, radius - y), k1 = std::min(tapCount, height + radius - y);
+        for (int k = k0; k < k1; ++k) {
+            AccumulateRow(rows + (size_t)(y + k - radius) * width, taps[k], width, out);
+        }
+    }
+}
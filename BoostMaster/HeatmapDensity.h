@@ -0,0 +1,57 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Gaussian splat for kernel density heatmaps. The 1D weights are precomputed at
+// kPhases sub-cell offsets per axis, so a sample is spread around its position
+// inside the cell rather than the cell centre, and the 2D kernel is their outer
+// product. Each phase is normalised, so a sample away from the edges adds exactly
+// its amount to the grid.
+class SplatKernel {
+public:
+    static constexpr int kPhases = 4;
+    // Wider kernels are clipped; use coarser cells for broader smoothing
+    static constexpr int kMaxRadius = 12;
+
+    // sigma in cells; <= 0 gives a single tap (plain binning)
+    void Build(float sigmaCells);
+
+    int Radius() const { return radius; }
+    // Standard deviation actually used, after clipping to kMaxRadius
+    float Sigma() const { return sigma; }
+
+    // Calls add(cellIndex, weight) for every tap inside a width x height row-major
+    // grid. u and v are continuous cell coordinates, clamped into the grid the same
+    // way HeatmapGrid::Index clamps positions.
+    template <typename Add>
+    void Splat(float u, float v, int width, int height, Add&& add) const {
+        u = std::clamp(u, 0.0f, (float)width - 1e-3f);
+        v = std::clamp(v, 0.0f, (float)height - 1e-3f);
+        const int cx = (int)u, cy = (int)v;
+        const float* wx = weights[std::min((int)((u - cx) * kPhases), kPhases - 1)];
+        const float* wy = weights[std::min((int)((v - cy) * kPhases), kPhases - 1)];
+        const int x0 = std::max(cx - radius, 0), x1 = std::min(cx + radius, width - 1);
+        const int y0 = std::max(cy - radius, 0), y1 = std::min(cy + radius, height - 1);
+        for (int y = y0; y <= y1; ++y) {
+            const float wrow = wy[y - cy + radius];
+            const size_t row = (size_t)y * width;
+            for (int x = x0; x <= x1; ++x) add(row + x, wrow * wx[x - cx + radius]);
+        }
+    }
+
+private:
+    int radius = 0;
+    float sigma = 0.0f;
+    float weights[kPhases][2 * kMaxRadius + 1] = {};
+};
+
+namespace Density {
+    // Normalised, centred Gaussian taps out to 3 sigma
+    std::vector<float> GaussianTaps(float sigmaCells);
+
+    // In-place separable Gaussian blur of a width x height row-major grid. Both
+    // passes run along rows with SIMD; values beyond the edges count as zero.
+    // scratch is reused between calls to avoid reallocating.
+    void GaussianBlur(float* grid, int width, int height, float sigmaCells, std::vector<float>& scratch);
+}
@@ -0,0 +1,425 @@
+#include "pch.h"
+#include "HeatmapGenerator.h"
+#include "Logger.h"
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+
+// HeatmapGenerator Implementation
+void HeatmapGenerator::Update(const TelemetryFrameStore& frames) {
+    // A cleared store restarts its sequence; a cleared heatmap ignores older frames
+    if (frames.Sequence() < consumedSequence || skipToLatest) {
+        consumedSequence = frames.Sequence();
+        skipToLatest = false;
+        return;
+    }
+    
+    size_t n = frames.NewSince(consumedSequence);
+    consumedSequence = frames.Sequence();
+    if (n == 0) return;
+    
+    auto times = frames.Time().Last(n);
+    auto xs = frames.PosX().Last(n);
+    auto ys = frames.PosY().Last(n);
+    auto zs = frames.PosZ().Last(n);
+    auto used = frames.BoostUsed().Last(n);
+    const bool splat = kernel.Radius() > 0;
+    const size_t cellsPerBand = positionGrid.CellsPerBand();
+    for (size_t i = 0; i < n; ++i) {
+        // Every sample lands somewhere and adds a (possibly zero) boost amount, so
+        // the loop has no per-sample branches beyond the mode and minute rollover
+        float t = times[i];
+        size_t cell = positionGrid.Index(Vector(xs[i], ys[i], zs[i]));
+        float spent = std::max(used[i], 0.0f);
+        
+        if (splat) {
+            const size_t bandStart = (size_t)positionGrid.BandOf(zs[i]) * cellsPerBand;
+            kernel.Splat(positionGrid.CellX(xs[i]), positionGrid.CellY(ys[i]), Width(), Height(),
+                [&](size_t tap, float weight) { Record(bandStart + tap, weight, weight * spent, t); });
+        }
+        else {
+            Record(cell, 1.0f, spent, t);
+        }
+        BucketFor(t).samples.push_back({t, (uint32_t)cell, spent});
+        boostSamples += spent > 0.0f;
+    }
+    positionSamples += n;
+    latestTime = std::max(latestTime, times[n - 1]);
+}
+
+void HeatmapGenerator::Record(size_t cell, float weight, float spent, float time) {
+    positionGrid[cell] += weight;
+    boostGrid[cell] += spent;
+    AddDecayed(decayedPosition[cell], weight, time);
+    AddDecayed(decayedBoost[cell], spent, time);
+}
+
+void HeatmapGenerator::AddDecayed(DecayCell& cell, float amount, float time) const {
+    cell.value = ReadDecayed(cell, time) + amount;
+    cell.time = std::max(cell.time, time);
+}
+
+float HeatmapGenerator::ReadDecayed(const DecayCell& cell, float time) const {
+    // Reads at or before the cell's time see it unscaled
+    return cell.value * std::exp2(std::min(0.0f, cell.time - time) / halfLife);
+}
+
+HeatmapGenerator::MinuteBucket& HeatmapGenerator::BucketFor(float time) {
+    const int64_t slots = retainedMinutes + 1;
+    if (minuteBuckets.empty()) minuteBuckets.resize((size_t)slots);
+    int64_t minute = (int64_t)std::floor(time / 60.0f);
+    MinuteBucket& bucket = minuteBuckets[(size_t)(((minute % slots) + slots) % slots)];
+    if (bucket.minute != minute) {
+        // Once per minute, not per sample; the allocation is kept
+        bucket.minute = minute;
+        bucket.samples.clear();
+    }
+    return bucket;
+}
+
+void HeatmapGenerator::SetHalfLife(float seconds) {
+    seconds = std::max(1.0f, seconds);
+    if (seconds == halfLife) return;
+    for (HeatmapGrid<DecayCell>* grid : {&decayedPosition, &decayedBoost}) {
+        for (size_t i = 0; i < grid->Size(); ++i) {
+            DecayCell& cell = (*grid)[i];
+            cell.value = ReadDecayed(cell, latestTime);
+            cell.time = std::max(cell.time, latestTime);
+        }
+    }
+    halfLife = seconds;
+}
+
+void HeatmapGenerator::SetResolution(float cellSize, bool heightBands) {
+    int bands = heightBands ? kHeightBandCount : 1;
+    positionGrid.Resize(cellSize, bands);
+    boostGrid.Resize(cellSize, bands);
+    decayedPosition.Resize(cellSize, bands);
+    decayedBoost.Resize(cellSize, bands);
+    kernel.Build(kernelBandwidth / CellSize());
+    ClearData();
+    
+    Logger::Log(LogLevel::INFO, "Heatmap", "Heatmap grid is " + std::to_string(Width()) + "x" +
+               std::to_string(Height()) + " cells of " + std::to_string((int)CellSize()) + "uu, " +
+               std::to_string(Bands()) + (Bands() > 1 ? " height bands" : " height band"));
+}
+
+void HeatmapGenerator::SetRecentMinutes(int minutes) {
+    recentMinutes = std::clamp(minutes, 1, MAX_RECENT_MINUTES);
+}
+
+void HeatmapGenerator::SetRetainedMinutes(int minutes) {
+    minutes = std::clamp(minutes, MAX_RECENT_MINUTES, MAX_RETAINED_MINUTES);
+    if (minutes == retainedMinutes) return;
+    retainedMinutes = minutes;
+    if (minuteBuckets.empty()) return;
+    
+    // Re-slot the minutes still in range into a ring of the new size
+    std::vector<MinuteBucket> old = std::move(minuteBuckets);
+    const int64_t slots = retainedMinutes + 1;
+    const int64_t current = (int64_t)std::floor(latestTime / 60.0f);
+    minuteBuckets.assign((size_t)slots, MinuteBucket{});
+    for (MinuteBucket& bucket : old) {
+        if (bucket.minute < 0 || bucket.minute > current || bucket.minute < current - retainedMinutes) continue;
+        minuteBuckets[(size_t)(((bucket.minute % slots) + slots) % slots)] = std::move(bucket);
+    }
+}
+
+void HeatmapGenerator::SetKernelBandwidth(float bandwidth) {
+    bandwidth = std::max(0.0f, bandwidth);
+    if (bandwidth == kernelBandwidth) return;
+    kernelBandwidth = bandwidth;
+    kernel.Build(kernelBandwidth / CellSize());
+    ClearData();
+    
+    if (kernel.Radius() > 0) {
+        Logger::Log(LogLevel::INFO, "Heatmap", "Kernel density with sigma " + std::to_string(kernel.Sigma() * CellSize()) +
+                   "uu (" + std::to_string(kernel.Radius() * 2 + 1) + "x" + std::to_string(kernel.Radius() * 2 + 1) + " cells)");
+    }
+}
+
+void HeatmapGenerator::BlurCumulative(float bandwidth) {
+    const float sigma = bandwidth / CellSize();
+    std::vector<float> scratch;
+    for (HeatmapGrid<float>* grid : {&positionGrid, &boostGrid}) {
+        for (int band = 0; band < Bands(); ++band) {
+            Density::GaussianBlur(grid->Band(band), Width(), Height(), sigma, scratch);
+        }
+    }
+}
+
+void HeatmapGenerator::Snapshot(HeatmapLayer layer, HeatmapView view, int band, float* out) const {
+    const bool boost = layer == HeatmapLayer::BoostUsage;
+    const size_t cells = positionGrid.CellsPerBand();
+    const int firstBand = band == ALL_BANDS ? 0 : band;
+    const int lastBand = band == ALL_BANDS ? Bands() : std::min(band + 1, Bands());
+    std::fill(out, out + cells, 0.0f);
+    
+    switch (view) {
+        case HeatmapView::Cumulative: {
+            const HeatmapGrid<float>& grid = boost ? boostGrid : positionGrid;
+            for (int b = firstBand; b < lastBand; ++b) {
+                const float* values = grid.Band(b);
+                for (size_t i = 0; i < cells; ++i) out[i] += values[i];
+            }
+            break;
+        }
+        case HeatmapView::Decayed: {
+            const HeatmapGrid<DecayCell>& grid = boost ? decayedBoost : decayedPosition;
+            for (int b = firstBand; b < lastBand; ++b) {
+                const DecayCell* values = grid.Band(b);
+                for (size_t i = 0; i < cells; ++i) out[i] += ReadDecayed(values[i], latestTime);
+            }
+            break;
+        }
+        case HeatmapView::Recent: {
+            // Whole minutes: the current one plus the recentMinutes - 1 before it.
+            // Samples outside the requested bands are weighted by zero, not skipped.
+            int64_t current = (int64_t)std::floor(latestTime / 60.0f);
+            for (const MinuteBucket& bucket : minuteBuckets) {
+                if (bucket.minute < 0 || bucket.minute > current || bucket.minute <= current - recentMinutes) continue;
+                for (const MinuteSample& sample : bucket.samples) {
+                    int sampleBand = (int)(sample.cell / cells);
+                    float weight = (float)((sampleBand >= firstBand) & (sampleBand < lastBand));
+                    out[sample.cell - (size_t)sampleBand * cells] += weight * (boost ? sample.boost : 1.0f);
+                }
+            }
+            // Minute samples keep only their cell, so the kernel is applied once here
+            if (kernel.Radius() > 0) {
+                std::vector<float> scratch;
+                Density::GaussianBlur(out, Width(), Height(), kernel.Sigma(), scratch);
+            }
+            break;
+        }
+    }
+}
+
+void HeatmapGenerator::GeneratePositionHeatmap() {
+    Logger::Log(LogLevel::INFO, "Heatmap", "Generating position heatmap with " + 
+               std::to_string(positionSamples) + " data points");
+    // Implementation for generating visual heatmap
+}
+
+void HeatmapGenerator::GenerateBoostUsageHeatmap() {
+    Logger::Log(LogLevel::INFO, "Heatmap", "Generating boost usage heatmap with " + 
+               std::to_string(boostSamples) + " data points");
+    // Implementation for generating boost usage heatmap
+}
+
+void HeatmapGenerator::ExportHeatmap(const std::string& filename, HeatmapView view) {
+    try {
+        std::filesystem::create_directories("data/heatmaps");
+        std::ofstream file("data/heatmaps/" + filename + ".csv");
+        
+        std::string suffix;
+        if (view == HeatmapView::Decayed) suffix = " (decayed, half-life " + std::to_string((int)halfLife) + "s)";
+        else if (view == HeatmapView::Recent) suffix = " (last " + std::to_string(recentMinutes) + " min)";
+        if (kernel.Radius() > 0) suffix += " (kernel sigma " + std::to_string((int)(kernel.Sigma() * CellSize())) + "uu)";
+        
+        static const char* bandNames[kHeightBandCount] = { "ground", "low air", "high air" };
+        
+        // Snapshots are row-major by y, so each CSV row is one contiguous run
+        const int width = Width();
+        std::vector<float> grid(positionGrid.CellsPerBand());
+        auto writeGrid = [&](HeatmapLayer layer, int band) {
+            Snapshot(layer, view, band, grid.data());
+            for (int y = 0; y < Height(); ++y) {
+                const float* row = grid.data() + (size_t)y * width;
+                for (int x = 0; x < width; ++x) {
+                    file << row[x];
+                    if (x < width - 1) file << ",";
+                }
+                file << "\n";
+            }
+        };
+        auto writeLayer = [&](HeatmapLayer layer, const char* title) {
+            file << title << suffix << ", " << width << "x" << Height() << " cells of " << CellSize() << "uu\n";
+            writeGrid(layer, ALL_BANDS);
+            for (int band = 0; Bands() > 1 && band < Bands(); ++band) {
+                file << "\n" << title << " - " << bandNames[band] << suffix << "\n";
+                writeGrid(layer, band);
+            }
+        };
+        
+        writeLayer(HeatmapLayer::Position, "Position Heatmap");
+        file << "\n";
+        writeLayer(HeatmapLayer::BoostUsage, "Boost Usage Heatmap");
+        
+        Logger::Log(LogLevel::INFO, "Heatmap", "Exported heatmap to " + filename + ".csv");
+    }
+    catch (const std::exception& e) {
+        Logger::Log(LogLevel::ERROR, "Heatmap", "Failed to export heatmap: " + std::string(e.what()));
+    }
+}
+
+void HeatmapGenerator::ExportImage(const std::string& filename, HeatmapLayer layer, HeatmapView view, int band,
+                                   const HeatmapImageOptions& options, HeatmapImageFormat format) {
+    try {
+        std::filesystem::create_directories("data/heatmaps");
+        
+        auto start = std::chrono::steady_clock::now();
+        std::vector<float> grid(positionGrid.CellsPerBand());
+        Snapshot(layer, view, band, grid.data());
+        HeatmapImage image = HeatmapRaster::Render(grid.data(), Width(), Height(), CellSize(), options);
+        double renderMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        std::string path = "data/heatmaps/" + filename + (format == HeatmapImageFormat::Ppm ? ".ppm" : ".png");
+        bool written = format == HeatmapImageFormat::Ppm ? HeatmapRaster::WritePpm(path, image) : HeatmapRaster::WritePng(path, image);
+        if (!written) {
+            Logger::Log(LogLevel::ERROR, "Heatmap", "Failed to write " + path);
+            return;
+        }
+        Logger::Log(LogLevel::INFO, "Heatmap", "Exported " + std::to_string(image.width) + "x" + std::to_string(image.height) +
+                   " image to " + path + " (rendered in " + std::to_string((int)renderMs) + "ms)");
+    }
+    catch (const std::exception& e) {
+        Logger::Log(LogLevel::ERROR, "Heatmap", "Failed to export heatmap image: " + std::string(e.what()));
+    }
+}
+
+void HeatmapGenerator::ExportTimelapse(const std::string& filename, HeatmapLayer layer, int band,
+                                       const HeatmapTimelapseOptions& timelapse, const HeatmapImageOptions& options) {
+    // Minutes the ring still holds, in time order; samples within a minute already
+    // are. The current minute and the retainedMinutes before it all have slots, so a
+    // session that long keeps its first partial minute. A slot not overwritten since
+    // a gap in play keeps its old minute, so older minutes are skipped.
+    const int64_t current = (int64_t)std::floor(latestTime / 60.0f);
+    std::vector<const MinuteBucket*> buckets;
+    for (const MinuteBucket& bucket : minuteBuckets) {
+        if (bucket.minute < 0 || bucket.minute > current || bucket.minute < current - retainedMinutes) continue;
+        if (!bucket.samples.empty()) buckets.push_back(&bucket);
+    }
+    if (buckets.empty()) {
+        Logger::Log(LogLevel::WARNING, "Heatmap", "No samples for a timelapse yet");
+        return;
+    }
+    std::sort(buckets.begin(), buckets.end(), [](const MinuteBucket* a, const MinuteBucket* b) { return a->minute < b->minute; });
+    
+    const bool boost = layer == HeatmapLayer::BoostUsage;
+    const size_t cells = positionGrid.CellsPerBand();
+    const int firstBand = band == ALL_BANDS ? 0 : band;
+    const int lastBand = band == ALL_BANDS ? Bands() : std::min(band + 1, Bands());
+    const float step = std::max(0.1f, timelapse.stepSeconds);
+    const float window = std::max(step, timelapse.windowSeconds);
+    const float sigma = timelapse.bandwidth >= 0.0f ? timelapse.bandwidth / CellSize() : (kernel.Radius() > 0 ? kernel.Sigma() : 0.0f);
+    const float startTime = buckets.front()->samples.front().time;
+    const float endTime = buckets.back()->samples.back().time;
+    const int frameCount = std::max(1, (int)std::ceil((endTime - startTime) / step));
+    
+    // Walks the kept samples in time order, adding each to (or taking it from) the
+    // window and counting the band's samples inside it
+    struct Cursor {
+        size_t bucket = 0;
+        size_t sample = 0;
+    };
+    int64_t inWindow = 0;
+    auto advance = [&](Cursor& cursor, float until, float sign, std::vector<float>& grid) {
+        while (cursor.bucket < buckets.size()) {
+            const std::vector<MinuteSample>& samples = buckets[cursor.bucket]->samples;
+            if (cursor.sample >= samples.size()) {
+                cursor.bucket++;
+                cursor.sample = 0;
+                continue;
+            }
+            const MinuteSample& sample = samples[cursor.sample];
+            if (sample.time > until) return;
+            int sampleBand = (int)(sample.cell / cells);
+            int inBand = (sampleBand >= firstBand) & (sampleBand < lastBand);
+            grid[sample.cell - (size_t)sampleBand * cells] += sign * inBand * (boost ? sample.boost : 1.0f);
+            inWindow += sign > 0.0f ? inBand : -inBand;
+            cursor.sample++;
+        }
+    };
+    
+    // Runs the window over the session, handing each finished frame to emit with
+    // its number. Steps whose window is empty (gaps in play) produce no frame.
+    std::vector<float> windowGrid, frame(cells), scratch;
+    int emitted = 0;
+    auto runFrames = [&](auto&& emit) {
+        windowGrid.assign(cells, 0.0f);
+        inWindow = 0;
+        emitted = 0;
+        Cursor head, tail;
+        for (int i = 1; i <= frameCount; ++i) {
+            float frameTime = std::min(startTime + i * step, endTime);
+            advance(head, frameTime, 1.0f, windowGrid);
+            advance(tail, frameTime - window, -1.0f, windowGrid);
+            if (inWindow <= 0) continue;
+            // Subtraction can leave rounding residue below zero
+            for (size_t c = 0; c < cells; ++c) frame[c] = std::max(0.0f, windowGrid[c]);
+            Density::GaussianBlur(frame.data(), Width(), Height(), sigma, scratch);
+            if (!emit(++emitted)) return false;
+        }
+        return true;
+    };
+    
+    try {
+        std::filesystem::create_directories("data/heatmaps");
+        auto start = std::chrono::steady_clock::now();
+        
+        // First pass fixes the colour scale so frames don't flicker between maxima
+        HeatmapImageOptions frameOptions = options;
+        if (frameOptions.maxValue <= 0.0f) {
+            float peak = 0.0f;
+            runFrames([&](int) { peak = std::max(peak, *std::max_element(frame.begin(), frame.end())); return true; });
+            frameOptions.maxValue = peak;
+        }
+        
+        bool written = true;
+        std::string path;
+        if (timelapse.format == HeatmapImageFormat::Gif) {
+            path = "data/heatmaps/" + filename + ".gif";
+            HeatmapRaster::GifWriter gif;
+            written = runFrames([&](int i) {
+                HeatmapImage image = HeatmapRaster::Render(frame.data(), Width(), Height(), CellSize(), frameOptions);
+                return i == 1 ? gif.Begin(path, image, timelapse.frameDelayMs) : gif.AddFrame(image);
+            }) && emitted > 0 && gif.Finish();
+        }
+        else {
+            const bool ppm = timelapse.format == HeatmapImageFormat::Ppm;
+            path = "data/heatmaps/" + filename + "_NNNN" + (ppm ? ".ppm" : ".png");
+            written = runFrames([&](int i) {
+                HeatmapImage image = HeatmapRaster::Render(frame.data(), Width(), Height(), CellSize(), frameOptions);
+                char number[16];
+                std::snprintf(number, sizeof(number), "%04d", i);
+                std::string framePath = "data/heatmaps/" + filename + "_" + number + (ppm ? ".ppm" : ".png");
+                return ppm ? HeatmapRaster::WritePpm(framePath, image) : HeatmapRaster::WritePng(framePath, image);
+            });
+        }
+        
+        if (emitted == 0) {
+            Logger::Log(LogLevel::WARNING, "Heatmap", "No samples in the selected band for a timelapse");
+            return;
+        }
+        if (!written) {
+            Logger::Log(LogLevel::ERROR, "Heatmap", "Failed to write timelapse " + path);
+            return;
+        }
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        Logger::Log(LogLevel::INFO, "Heatmap", "Exported " + std::to_string(emitted) + " frame timelapse (" +
+                   std::to_string((int)window) + "s window every " + std::to_string((int)step) + "s) to " + path +
+                   " in " + std::to_string((int)elapsedMs) + "ms");
+    }
+    catch (const std::exception& e) {
+        Logger::Log(LogLevel::ERROR, "Heatmap", "Failed to export heatmap timelapse: " + std::string(e.what()));
+    }
+}
+
+void HeatmapGenerator::ClearData() {
+    skipToLatest = true;
+    positionSamples = 0;
+    boostSamples = 0;
+    
+    // Clear grids
+    positionGrid.Clear();
+    boostGrid.Clear();
+    decayedPosition.Clear();
+    decayedBoost.Clear();
+    minuteBuckets.clear();
+    latestTime = 0.0f;
+    
+    Logger::Log(LogLevel::INFO, "Heatmap", "Cleared all heatmap data");
+}
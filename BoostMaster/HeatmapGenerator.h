@@ -0,0 +1,139 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "bakkesmod/wrappers/WrapperStructs.h"
+#include "TelemetryFrameStore.h"
+#include "HeatmapGrid.h"
+#include "HeatmapDensity.h"
+#include "HeatmapImage.h"
+
+// Which history a heatmap read covers
+enum class HeatmapView {
+    Cumulative, // every sample since the last clear
+    Decayed,    // exponentially weighted, halving every half-life
+    Recent,     // the last N whole minutes
+};
+
+enum class HeatmapLayer {
+    Position,
+    BoostUsage,
+};
+
+// How a timelapse steps through the session
+struct HeatmapTimelapseOptions {
+    float windowSeconds = 60.0f; // each frame shows the samples this long before its time
+    float stepSeconds = 10.0f;   // session time between frames
+    float bandwidth = -1.0f;     // Gaussian smoothing per frame in uu; below 0 follows the kernel bandwidth
+    int frameDelayMs = 100;
+    HeatmapImageFormat format = HeatmapImageFormat::Gif; // Png or Ppm write numbered frames
+};
+
+// Heatmap System
+class HeatmapGenerator {
+public:
+    static const int MAX_RECENT_MINUTES = 30;
+    // Minutes of per-sample history kept for the recent view and timelapses; never
+    // below MAX_RECENT_MINUTES, so the recent view always has its minutes
+    static const int DEFAULT_RETAINED_MINUTES = 60;
+    static const int MAX_RETAINED_MINUTES = 240;
+    // Snapshot band that sums ground, low air and high air
+    static const int ALL_BANDS = -1;
+    
+    // Fold frames pushed since the previous call into the grids
+    void Update(const TelemetryFrameStore& frames);
+    void GenerateBoostUsageHeatmap();
+    void GeneratePositionHeatmap();
+    void ExportHeatmap(const std::string& filename, HeatmapView view = HeatmapView::Cumulative);
+    // Colormapped image of one layer and band to data/heatmaps/<filename>.png or .ppm
+    void ExportImage(const std::string& filename, HeatmapLayer layer, HeatmapView view, int band,
+                     const HeatmapImageOptions& options, HeatmapImageFormat format = HeatmapImageFormat::Png);
+    // Sliding-window animation over the retained samples: the current minute and the
+    // RetainedMinutes() before it, so a session of that length is covered from its
+    // first partial minute. Each step adds the samples entering the window and
+    // subtracts those leaving it, so a frame costs its new samples, not a rebuild.
+    // Every frame shares one colour scale so they can be compared; steps whose
+    // window is empty, such as gaps between matches, are left out.
+    void ExportTimelapse(const std::string& filename, HeatmapLayer layer, int band,
+                         const HeatmapTimelapseOptions& timelapse, const HeatmapImageOptions& options);
+    void ClearData();
+    
+    // Changing the half-life settles every cell under the old one first
+    void SetHalfLife(float seconds);
+    float HalfLife() const { return halfLife; }
+    void SetRecentMinutes(int minutes);
+    int RecentMinutes() const { return recentMinutes; }
+    // Memory grows with the samples actually kept, about 12 bytes each; shrinking
+    // drops the oldest minutes
+    void SetRetainedMinutes(int minutes);
+    int RetainedMinutes() const { return retainedMinutes; }
+    
+    // Cell edge in unreal units and whether height bands are kept; clears the data
+    void SetResolution(float cellSize, bool heightBands);
+    float CellSize() const { return positionGrid.CellSize(); }
+    int Width() const { return positionGrid.Width(); }
+    int Height() const { return positionGrid.Height(); }
+    int Bands() const { return positionGrid.Bands(); }
+    
+    // Gaussian bandwidth in unreal units for kernel density: each sample is splatted
+    // over neighbouring cells instead of dropped into one. 0 keeps plain bins.
+    // Clears the data, since grids recorded under different kernels don't mix.
+    void SetKernelBandwidth(float bandwidth);
+    float KernelBandwidth() const { return kernelBandwidth; }
+    // Offline rebuild: smooths the cumulative grids in place with a separable
+    // Gaussian. Meant for fine histograms binned from a whole recording with a
+    // bandwidth of 0, where blurring once is far cheaper than splatting every sample.
+    void BlurCumulative(float bandwidth);
+    
+    // One layer as seen through view at the newest sample time; out holds
+    // Width() * Height() values, row-major by y. band is a HeightBand index, or
+    // ALL_BANDS; without height bands every sample is in band 0.
+    void Snapshot(HeatmapLayer layer, HeatmapView view, int band, float* out) const;
+    
+private:
+    // A decayed value and the time it was last brought up to date; reads and writes
+    // rescale by 2^(-elapsed / halfLife) first, so no tick ever sweeps the grid
+    struct DecayCell {
+        float value = 0.0f;
+        float time = 0.0f;
+    };
+    
+    // One sample's time, cell and boost spent, kept per minute for the recent view
+    // and timelapses
+    struct MinuteSample {
+        float time;
+        uint32_t cell;
+        float boost;
+    };
+    
+    // One minute's samples, in time order, in a ring of retainedMinutes + 1 slots; a
+    // slot is reused when its minute comes round. Sized by samples rather than cells,
+    // so fine grids stay cheap.
+    struct MinuteBucket {
+        int64_t minute = -1;
+        std::vector<MinuteSample> samples;
+    };
+    
+    uint64_t consumedSequence = 0;
+    bool skipToLatest = false;
+    size_t positionSamples = 0;
+    size_t boostSamples = 0;
+    HeatmapGrid<float> positionGrid{100.0f, kHeightBandCount};
+    HeatmapGrid<float> boostGrid{100.0f, kHeightBandCount};
+    
+    float halfLife = 300.0f;
+    int recentMinutes = 5;
+    int retainedMinutes = DEFAULT_RETAINED_MINUTES;
+    float latestTime = 0.0f;
+    HeatmapGrid<DecayCell> decayedPosition{100.0f, kHeightBandCount};
+    HeatmapGrid<DecayCell> decayedBoost{100.0f, kHeightBandCount};
+    std::vector<MinuteBucket> minuteBuckets;
+    
+    float kernelBandwidth = 0.0f;
+    SplatKernel kernel;
+    
+    void Record(size_t cell, float weight, float spent, float time);
+    void AddDecayed(DecayCell& cell, float amount, float time) const;
+    float ReadDecayed(const DecayCell& cell, float time) const;
+    MinuteBucket& BucketFor(float time);
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include "bakkesmod/wrappers/WrapperStructs.h"
+
+// Height bands for separating ground play from aerials
+enum class HeightBand : int {
+    Ground,  // below kGroundMaxZ (driving, including small hops)
+    LowAir,  // up to kLowAirMaxZ, roughly crossbar height
+    HighAir,
+};
+constexpr int kHeightBandCount = 3;
+
+// Allocator for cache-line aligned grid storage
+template <typename T, size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment))); }
+    void deallocate(T* p, size_t) { ::operator delete(p, std::align_val_t(Alignment)); }
+
+    template <typename U> bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+// Flat heatmap over the arena floor with a runtime cell size and optional height
+// bands. Storage is one 64-byte aligned block laid out [band][y][x], so a row is
+// contiguous in x and exporting rows by y walks memory in order. Index() clamps
+// into the grid instead of rejecting, so positions past the walls or in the goals
+// land on the edge cells and recording has no data-dependent branches.
+template <typename T>
+class HeatmapGrid {
+public:
+    static constexpr float kMinX = -4096.0f;
+    static constexpr float kMaxX = 4096.0f;
+    static constexpr float kMinY = -5120.0f;
+    static constexpr float kMaxY = 5120.0f;
+    static constexpr float kGroundMaxZ = 100.0f;
+    static constexpr float kLowAirMaxZ = 650.0f;
+    static constexpr float kMinCellSize = 25.0f;
+    static constexpr float kMaxCellSize = 400.0f;
+
+    HeatmapGrid() = default;
+    HeatmapGrid(float cellSize, int bandCount) { Resize(cellSize, bandCount); }
+
+    // Reallocates and clears; cellSize is clamped to [kMinCellSize, kMaxCellSize]
+    // and bandCount to 1 or kHeightBandCount
+    void Resize(float newCellSize, int bandCount) {
+        cellSize = std::clamp(newCellSize, kMinCellSize, kMaxCellSize);
+        invCellSize = 1.0f / cellSize;
+        width = (int)((kMaxX - kMinX) / cellSize + 0.999f);
+        height = (int)((kMaxY - kMinY) / cellSize + 0.999f);
+        bands = bandCount > 1 ? kHeightBandCount : 1;
+        cells.assign((size_t)width * height * bands, T{});
+    }
+
+    void Clear() { std::fill(cells.begin(), cells.end(), T{}); }
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    int Bands() const { return bands; }
+    float CellSize() const { return cellSize; }
+    size_t CellsPerBand() const { return (size_t)width * height; }
+    size_t Size() const { return cells.size(); }
+    bool Empty() const { return cells.empty(); }
+
+    // Continuous cell coordinates of a world position; the cell is their floor
+    float CellX(float worldX) const { return (worldX - kMinX) * invCellSize; }
+    float CellY(float worldY) const { return (worldY - kMinY) * invCellSize; }
+    int BandOf(float worldZ) const { return std::min((int)(worldZ >= kGroundMaxZ) + (int)(worldZ >= kLowAirMaxZ), bands - 1); }
+
+    // Cell holding a world position
+    size_t Index(const Vector& p) const {
+        int x = std::clamp((int)CellX(p.X), 0, width - 1);
+        int y = std::clamp((int)CellY(p.Y), 0, height - 1);
+        return ((size_t)BandOf(p.Z) * height + y) * width + x;
+    }
+
+    T& operator[](size_t i) { return cells[i]; }
+    const T& operator[](size_t i) const { return cells[i]; }
+    T* Data() { return cells.data(); }
+    const T* Data() const { return cells.data(); }
+    // First cell of a band; CellsPerBand() values, row-major by y
+    T* Band(int band) { return cells.data() + (size_t)band * CellsPerBand(); }
+    const T* Band(int band) const { return cells.data() + (size_t)band * CellsPerBand(); }
+
+private:
+    float cellSize = 0.0f;
+    float invCellSize = 0.0f;
+    int width = 0;
+    int height = 0;
+    int bands = 1;
+    std::vector<T, AlignedAllocator<T, 64>> cells;
+};
@@ -0,0 +1,458 @@
+#include "pch.h"
+#include "HeatmapImage.h"
+#include "HeatmapGrid.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <thread>
+
+namespace {
+    using Rgb = std::array<uint8_t, 3>;
+    using Lut = std::array<Rgb, 256>;
+
+    // Nine evenly spaced stops of each matplotlib colormap, interpolated to the
+    // palette's colormap entries
+    constexpr uint8_t kViridisStops[9][3] = {
+        {68, 1, 84}, {71, 45, 123}, {59, 82, 139}, {44, 114, 142}, {33, 144, 140},
+        {39, 173, 129}, {93, 200, 99}, {170, 220, 50}, {253, 231, 37},
+    };
+    constexpr uint8_t kInfernoStops[9][3] = {
+        {0, 0, 4}, {33, 12, 74}, {86, 16, 110}, {137, 34, 106}, {187, 55, 84},
+        {227, 89, 50}, {249, 140, 10}, {249, 201, 50}, {252, 255, 164},
+    };
+
+    Lut BuildLut(const uint8_t (&stops)[9][3]) {
+        Lut lut{};
+        for (int i = 0; i < HeatmapRaster::kColormapEntries; ++i) {
+            float position = i / (float)(HeatmapRaster::kColormapEntries - 1) * 8.0f;
+            int stop = std::min((int)position, 7);
+            float t = position - stop;
+            for (int c = 0; c < 3; ++c) {
+                lut[i][c] = (uint8_t)std::lround(stops[stop][c] + (stops[stop + 1][c] - stops[stop][c]) * t);
+            }
+        }
+        // Overlay colours take the remaining entries
+        lut[HeatmapRaster::kOutsideIndex] = {0, 0, 0};
+        lut[HeatmapRaster::kLineIndex] = {235, 235, 235};
+        lut[HeatmapRaster::kBigPadIndex] = {255, 190, 40};
+        lut[HeatmapRaster::kSmallPadIndex] = {200, 200, 200};
+        return lut;
+    }
+
+    const Lut& ColormapLut(HeatmapColormap colormap) {
+        static const Lut viridis = BuildLut(kViridisStops);
+        static const Lut inferno = BuildLut(kInfernoStops);
+        return colormap == HeatmapColormap::Inferno ? inferno : viridis;
+    }
+
+    // Normalised value to colormap index with the gamma curve baked in, so no pixel calls pow
+    constexpr int kToneSteps = 4096;
+
+    constexpr float kFieldMinX = HeatmapGrid<float>::kMinX;
+    constexpr float kFieldMaxY = HeatmapGrid<float>::kMaxY;
+    constexpr float kFieldSpanX = HeatmapGrid<float>::kMaxX - HeatmapGrid<float>::kMinX;
+    constexpr float kFieldSpanY = HeatmapGrid<float>::kMaxY - HeatmapGrid<float>::kMinY;
+    // Wall-to-wall |x| + |y| limit of the chamfered corners
+    constexpr float kCornerLimit = 8064.0f;
+    constexpr float kGoalHalfWidth = 893.0f;
+    constexpr float kBigPadRadius = 208.0f;
+    constexpr float kSmallPadRadius = 144.0f;
+
+    struct RasterJob {
+        const float* grid;
+        int gridWidth;
+        int gridHeight;
+        float invCellSize;
+        const HeatmapImageOptions* options;
+        std::vector<uint8_t> tone; // kToneSteps colormap indices
+        float toneScale;           // value to tone index
+        std::vector<int> column0;  // per pixel column: left grid cell, right cell and weight
+        std::vector<int> column1;
+        std::vector<float> columnWeight;
+        float pixelSize;           // uu per pixel
+        HeatmapImage* image;
+
+        void RenderRows(int rowBegin, int rowEnd) const {
+            const int width = image->width;
+            const float lineWidth = std::max(1.5f * pixelSize, 20.0f);
+            for (int py = rowBegin; py < rowEnd; ++py) {
+                const float wy = kFieldMaxY - (py + 0.5f) * pixelSize;
+                // Bilinear between cell centres, clamped at the edges
+                float gy = std::clamp((wy - HeatmapGrid<float>::kMinY) * invCellSize - 0.5f, 0.0f, (float)(gridHeight - 1));
+                int y0 = (int)gy, y1 = std::min(y0 + 1, gridHeight - 1);
+                float fy = gy - y0;
+                const float* row0 = grid + (size_t)y0 * gridWidth;
+                const float* row1 = grid + (size_t)y1 * gridWidth;
+                uint8_t* out = image->pixels.data() + (size_t)py * width;
+
+                for (int px = 0; px < width; ++px) {
+                    float fx = columnWeight[px];
+                    float top = row0[column0[px]] + (row0[column1[px]] - row0[column0[px]]) * fx;
+                    float bottom = row1[column0[px]] + (row1[column1[px]] - row1[column0[px]]) * fx;
+                    float value = top + (bottom - top) * fy;
+                    out[px] = tone[std::clamp((int)(value * toneScale), 0, kToneSteps - 1)];
+                }
+
+                if (options->outline) DrawOutline(out, wy, lineWidth);
+                if (options->pads) DrawPads(out, wy, lineWidth);
+            }
+        }
+
+        // Sets the pixels whose centres lie in [x0, x1] world units
+        void FillSpan(uint8_t* out, float x0, float x1, uint8_t index) const {
+            int px0 = std::max(0, (int)std::ceil((x0 - kFieldMinX) / pixelSize - 0.5f));
+            int px1 = std::min(image->width - 1, (int)std::floor((x1 - kFieldMinX) / pixelSize - 0.5f));
+            if (px0 <= px1) std::fill(out + px0, out + px1 + 1, index);
+        }
+
+        // Works in spans per row: the walls cross a row at two mirrored x positions,
+        // so only the end walls, halfway line and goal mouths touch a whole run
+        void DrawOutline(uint8_t* out, float wy, float lineWidth) const {
+            using HeatmapRaster::kLineIndex;
+            const float ay = std::abs(wy);
+            const float maxX = HeatmapGrid<float>::kMaxX;
+            const float endDistance = HeatmapGrid<float>::kMaxY - ay;
+            // Where the side wall or corner chamfer crosses this row; chamfer lines
+            // are sqrt(2) wider horizontally for the same thickness
+            const float wallX = std::min(maxX, kCornerLimit - ay);
+            const float sideWidth = wallX < maxX ? lineWidth * 1.41421356f : lineWidth;
+
+            // Outside the chamfers is not part of the arena
+            FillSpan(out, kFieldMinX, -wallX - sideWidth, HeatmapRaster::kOutsideIndex);
+            FillSpan(out, wallX + sideWidth, maxX, HeatmapRaster::kOutsideIndex);
+
+            if (endDistance <= lineWidth || ay <= lineWidth * 0.5f) {
+                FillSpan(out, -wallX - sideWidth, wallX + sideWidth, kLineIndex);
+                return;
+            }
+            if (endDistance <= lineWidth * 3.0f) FillSpan(out, -kGoalHalfWidth, kGoalHalfWidth, kLineIndex);
+            FillSpan(out, -wallX - sideWidth, -wallX + sideWidth, kLineIndex);
+            FillSpan(out, wallX - sideWidth, wallX + sideWidth, kLineIndex);
+        }
+
+        void DrawPads(uint8_t* out, float wy, float lineWidth) const {
+            const int width = image->width;
+            for (const StaticBoostPad& pad : *options->pads) {
+                const bool big = pad.type == PadType::Big;
+                const float radius = big ? kBigPadRadius : kSmallPadRadius;
+                const float dy = wy - pad.location.Y;
+                if (std::abs(dy) > radius + lineWidth) continue;
+                // Only the pixels on this row's chord of the ring
+                int px0 = std::max(0, (int)((pad.location.X - radius - lineWidth - kFieldMinX) / pixelSize));
+                int px1 = std::min(width - 1, (int)((pad.location.X + radius + lineWidth - kFieldMinX) / pixelSize));
+                const uint8_t index = big ? HeatmapRaster::kBigPadIndex : HeatmapRaster::kSmallPadIndex;
+                for (int px = px0; px <= px1; ++px) {
+                    float dx = kFieldMinX + (px + 0.5f) * pixelSize - pad.location.X;
+                    if (std::abs(std::sqrt(dx * dx + dy * dy) - radius) <= lineWidth * 0.75f) out[px] = index;
+                }
+            }
+        }
+    };
+
+    uint32_t Crc32(uint32_t crc, const uint8_t* data, size_t size) {
+        static const std::array<uint32_t, 256> table = [] {
+            std::array<uint32_t, 256> t{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[i] = c;
+            }
+            return t;
+        }();
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    uint32_t Adler32(uint32_t adler, const uint8_t* data, size_t size) {
+        uint32_t a = adler & 0xFFFF, b = adler >> 16;
+        while (size > 0) {
+            // 5552 is the largest run before b can overflow 32 bits
+            size_t run = std::min<size_t>(size, 5552);
+            for (size_t i = 0; i < run; ++i) {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+            data += run;
+            size -= run;
+        }
+        return (b << 16) | a;
+    }
+
+    void PutBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back((uint8_t)(value >> 24));
+        out.push_back((uint8_t)(value >> 16));
+        out.push_back((uint8_t)(value >> 8));
+        out.push_back((uint8_t)value);
+    }
+
+    void WriteChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data) {
+        std::vector<uint8_t> header;
+        PutBigEndian(header, (uint32_t)data.size());
+        header.insert(header.end(), type, type + 4);
+        uint32_t crc = Crc32(0, header.data() + 4, 4);
+        crc = Crc32(crc, data.data(), data.size());
+        std::vector<uint8_t> trailer;
+        PutBigEndian(trailer, crc);
+
+        file.write(reinterpret_cast<const char*>(header.data()), header.size());
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        file.write(reinterpret_cast<const char*>(trailer.data()), trailer.size());
+    }
+
+    void PutLittleEndian16(std::vector<uint8_t>& out, int value) {
+        out.push_back((uint8_t)value);
+        out.push_back((uint8_t)(value >> 8));
+    }
+
+    // GIF's variable-width LZW. The dictionary is an open-addressed hash of
+    // (prefix code, next index) pairs rather than a 4096 x 256 trie, so clearing it
+    // when it fills is cheap.
+    class LzwEncoder {
+    public:
+        static constexpr uint8_t kMinCodeSize = 8;
+
+        void Encode(const uint8_t* pixels, size_t count, std::vector<uint8_t>& out) {
+            output = &out;
+            Reset();
+            Emit(kClearCode);
+            if (count == 0) {
+                Emit(kEndCode);
+                Flush();
+                return;
+            }
+
+            int prefix = pixels[0];
+            for (size_t i = 1; i < count; ++i) {
+                const int32_t key = (prefix << 8) | pixels[i];
+                size_t slot = Slot(key);
+                if (keys[slot] == key) {
+                    prefix = codes[slot];
+                    continue;
+                }
+
+                Emit(prefix);
+                const int code = ++lastCode;
+                keys[slot] = key;
+                codes[slot] = (uint16_t)code;
+                // The decoder widens its codes when its table reaches the next power of two
+                if (code >= (1 << codeSize)) codeSize++;
+                if (code == kMaxCode) {
+                    Emit(kClearCode);
+                    Reset();
+                }
+                prefix = pixels[i];
+            }
+            Emit(prefix);
+            Emit(kEndCode);
+            Flush();
+        }
+
+    private:
+        static constexpr int kClearCode = 1 << kMinCodeSize;
+        static constexpr int kEndCode = kClearCode + 1;
+        static constexpr int kMaxCode = 4095;
+        static constexpr size_t kHashSize = 8192; // at most 3838 entries, so probes stay short
+
+        void Reset() {
+            std::fill(std::begin(keys), std::end(keys), -1);
+            codeSize = kMinCodeSize + 1;
+            lastCode = kEndCode;
+        }
+
+        size_t Slot(int32_t key) const {
+            size_t slot = ((uint32_t)key * 2654435761u) >> 19;
+            while (keys[slot] != -1 && keys[slot] != key) slot = (slot + 1) & (kHashSize - 1);
+            return slot;
+        }
+
+        // Codes are packed least significant bit first
+        void Emit(int code) {
+            bits |= (uint32_t)code << bitCount;
+            bitCount += codeSize;
+            while (bitCount >= 8) {
+                output->push_back((uint8_t)bits);
+                bits >>= 8;
+                bitCount -= 8;
+            }
+        }
+
+        void Flush() {
+            if (bitCount > 0) output->push_back((uint8_t)bits);
+            bits = 0;
+            bitCount = 0;
+        }
+
+        int32_t keys[kHashSize];
+        uint16_t codes[kHashSize];
+        int codeSize = kMinCodeSize + 1;
+        int lastCode = kEndCode;
+        uint32_t bits = 0;
+        int bitCount = 0;
+        std::vector<uint8_t>* output = nullptr;
+    };
+}
+
+HeatmapImage HeatmapRaster::Render(const float* grid, int gridWidth, int gridHeight, float cellSize, const HeatmapImageOptions& options) {
+    HeatmapImage image;
+    image.width = std::clamp(options.width, 16, 8192);
+    image.height = std::max(1, (int)std::lround(image.width * kFieldSpanY / kFieldSpanX));
+    image.pixels.resize((size_t)image.width * image.height);
+    const Lut& lut = ColormapLut(options.colormap);
+    for (size_t i = 0; i < lut.size(); ++i) std::copy(lut[i].begin(), lut[i].end(), image.palette.begin() + i * 3);
+
+    RasterJob job;
+    job.grid = grid;
+    job.gridWidth = gridWidth;
+    job.gridHeight = gridHeight;
+    job.invCellSize = 1.0f / cellSize;
+    job.options = &options;
+    job.pixelSize = kFieldSpanX / image.width;
+    job.image = &image;
+
+    float maxValue = options.maxValue;
+    if (maxValue <= 0.0f && gridWidth > 0 && gridHeight > 0) maxValue = *std::max_element(grid, grid + (size_t)gridWidth * gridHeight);
+    job.toneScale = maxValue > 0.0f ? (kToneSteps - 1) / maxValue : 0.0f;
+    job.tone.resize(kToneSteps);
+    const float gamma = std::max(0.05f, options.gamma);
+    for (int i = 0; i < kToneSteps; ++i) {
+        job.tone[i] = (uint8_t)std::lround((HeatmapRaster::kColormapEntries - 1) * std::pow(i / (float)(kToneSteps - 1), gamma));
+    }
+
+    // Column lookups are shared by every row
+    job.column0.resize(image.width);
+    job.column1.resize(image.width);
+    job.columnWeight.resize(image.width);
+    for (int px = 0; px < image.width; ++px) {
+        float wx = kFieldMinX + (px + 0.5f) * job.pixelSize;
+        float gx = std::clamp((wx - kFieldMinX) * job.invCellSize - 0.5f, 0.0f, (float)(gridWidth - 1));
+        job.column0[px] = (int)gx;
+        job.column1[px] = std::min(job.column0[px] + 1, gridWidth - 1);
+        job.columnWeight[px] = gx - job.column0[px];
+    }
+
+    // Bands of at least 32 rows, one per thread; this thread renders the first
+    int threads = options.threads > 0 ? options.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = std::clamp(threads, 1, std::max(1, image.height / 32));
+    const int rowsPerThread = (image.height + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; ++t) {
+        int begin = t * rowsPerThread, end = std::min(image.height, begin + rowsPerThread);
+        if (begin < end) workers.emplace_back([&job, begin, end] { job.RenderRows(begin, end); });
+    }
+    job.RenderRows(0, std::min(image.height, rowsPerThread));
+    for (std::thread& worker : workers) worker.join();
+
+    return image;
+}
+
+bool HeatmapRaster::WritePng(const std::string& path, const HeatmapImage& image) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    std::vector<uint8_t> header;
+    PutBigEndian(header, (uint32_t)image.width);
+    PutBigEndian(header, (uint32_t)image.height);
+    header.insert(header.end(), { 8, 3, 0, 0, 0 }); // 8-bit palette indices, no interlace
+    WriteChunk(file, "IHDR", header);
+    WriteChunk(file, "PLTE", std::vector<uint8_t>(image.palette.begin(), image.palette.end()));
+
+    // zlib stream of stored blocks; every row is prefixed with filter type 0
+    const size_t rowBytes = (size_t)image.width;
+    const size_t rawSize = (rowBytes + 1) * image.height;
+    std::vector<uint8_t> raw(rawSize);
+    for (int y = 0; y < image.height; ++y) {
+        raw[y * (rowBytes + 1)] = 0;
+        std::copy_n(image.pixels.data() + y * rowBytes, rowBytes, raw.data() + y * (rowBytes + 1) + 1);
+    }
+
+    constexpr size_t kMaxStored = 65535;
+    std::vector<uint8_t> data;
+    data.reserve(rawSize + rawSize / kMaxStored * 5 + 16);
+    data.push_back(0x78);
+    data.push_back(0x01);
+    for (size_t offset = 0; offset < rawSize; offset += kMaxStored) {
+        size_t length = std::min(kMaxStored, rawSize - offset);
+        data.push_back(offset + length >= rawSize ? 1 : 0);
+        data.push_back((uint8_t)length);
+        data.push_back((uint8_t)(length >> 8));
+        data.push_back((uint8_t)~length);
+        data.push_back((uint8_t)(~length >> 8));
+        data.insert(data.end(), raw.begin() + offset, raw.begin() + offset + length);
+    }
+    PutBigEndian(data, Adler32(1, raw.data(), raw.size()));
+    WriteChunk(file, "IDAT", data);
+    WriteChunk(file, "IEND", {});
+
+    return (bool)file;
+}
+
+bool HeatmapRaster::WritePpm(const std::string& path, const HeatmapImage& image) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file << "P6\n" << image.width << " " << image.height << "\n255\n";
+    std::vector<uint8_t> row((size_t)image.width * 3);
+    for (int y = 0; y < image.height; ++y) {
+        const uint8_t* pixels = image.pixels.data() + (size_t)y * image.width;
+        for (int x = 0; x < image.width; ++x) std::copy_n(image.palette.begin() + pixels[x] * 3, 3, row.begin() + x * 3);
+        file.write(reinterpret_cast<const char*>(row.data()), row.size());
+    }
+    return (bool)file;
+}
+
+bool HeatmapRaster::GifWriter::Begin(const std::string& path, const HeatmapImage& first, int frameDelayMs) {
+    file.open(path, std::ios::binary);
+    if (!file) return false;
+    width = first.width;
+    height = first.height;
+    delayCentiseconds = std::clamp((frameDelayMs + 5) / 10, 2, 65535);
+
+    // Logical screen with a 256-entry global colour table
+    std::vector<uint8_t> header = { 'G', 'I', 'F', '8', '9', 'a' };
+    PutLittleEndian16(header, width);
+    PutLittleEndian16(header, height);
+    header.insert(header.end(), { 0xF7, 0, 0 });
+    header.insert(header.end(), first.palette.begin(), first.palette.end());
+    // Loop forever
+    header.insert(header.end(), { 0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 0x03, 0x01, 0x00, 0x00, 0x00 });
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+    return AddFrame(first);
+}
+
+bool HeatmapRaster::GifWriter::AddFrame(const HeatmapImage& frame) {
+    if (!file || frame.width != width || frame.height != height) return false;
+
+    std::vector<uint8_t> block = { 0x21, 0xF9, 0x04, 0x00 };
+    PutLittleEndian16(block, delayCentiseconds);
+    block.insert(block.end(), { 0x00, 0x00, 0x2C, 0, 0, 0, 0 });
+    PutLittleEndian16(block, width);
+    PutLittleEndian16(block, height);
+    block.insert(block.end(), { 0x00, LzwEncoder::kMinCodeSize });
+
+    std::vector<uint8_t> codes;
+    LzwEncoder().Encode(frame.pixels.data(), frame.pixels.size(), codes);
+    // Data goes out in sub-blocks of at most 255 bytes
+    for (size_t offset = 0; offset < codes.size(); offset += 255) {
+        size_t length = std::min<size_t>(255, codes.size() - offset);
+        block.push_back((uint8_t)length);
+        block.insert(block.end(), codes.begin() + offset, codes.begin() + offset + length);
+    }
+    block.push_back(0x00);
+
+    file.write(reinterpret_cast<const char*>(block.data()), block.size());
+    return (bool)file;
+}
+
+bool HeatmapRaster::GifWriter::Finish() {
+    if (!file.is_open()) return false;
+    file.put(0x3B);
+    bool ok = (bool)file;
+    file.close();
+    return ok;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "BoostPadData.h"
+
+enum class HeatmapColormap {
+    Viridis,
+    Inferno,
+};
+
+enum class HeatmapImageFormat {
+    Png,
+    Ppm,
+    Gif, // timelapses only; a single image is written as PNG
+};
+
+struct HeatmapImageOptions {
+    int width = 1024;     // pixels across the field's X extent; the height follows its aspect
+    HeatmapColormap colormap = HeatmapColormap::Viridis;
+    float gamma = 0.5f;   // below 1 lifts sparsely visited areas
+    float maxValue = 0.0f; // value drawn at the top of the colormap; 0 uses the grid's maximum
+    bool outline = true;  // arena walls, corners, halfway line and goal mouths
+    const std::vector<StaticBoostPad>* pads = nullptr; // drawn as rings when set
+    int threads = 0;      // 0 uses every hardware thread
+};
+
+// Palettised pixels, rows top (+Y, orange goal) to bottom. The first
+// HeatmapRaster::kColormapEntries palette entries are the colormap; the rest are
+// the overlay colours.
+struct HeatmapImage {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+    std::array<uint8_t, 256 * 3> palette = {};
+};
+
+// Heatmap rasterisation and dependency-free image encoding. Render splits the image
+// into bands of rows across threads; each pixel is a bilinear read of the grid
+// mapped to a colormap index, with overlays drawn in the same pass. Images are
+// palettised so PNG, PPM and GIF frames all come from the same pixels.
+namespace HeatmapRaster {
+    constexpr int kColormapEntries = 252;
+    constexpr uint8_t kOutsideIndex = 252;
+    constexpr uint8_t kLineIndex = 253;
+    constexpr uint8_t kBigPadIndex = 254;
+    constexpr uint8_t kSmallPadIndex = 255;
+
+    // grid is gridWidth x gridHeight cells of cellSize uu, row-major by y, covering
+    // the HeatmapGrid field extents from its low corner
+    HeatmapImage Render(const float* grid, int gridWidth, int gridHeight, float cellSize, const HeatmapImageOptions& options);
+
+    // Indexed-colour PNG with stored (uncompressed) deflate blocks, so no zlib is needed
+    bool WritePng(const std::string& path, const HeatmapImage& image);
+    // Binary PPM (P6)
+    bool WritePpm(const std::string& path, const HeatmapImage& image);
+
+    // Animated GIF89a writer; every frame must share the first frame's size and
+    // palette. Frames are LZW-compressed as they are added.
+    class GifWriter {
+    public:
+        bool Begin(const std::string& path, const HeatmapImage& first, int frameDelayMs);
+        bool AddFrame(const HeatmapImage& frame);
+        bool Finish();
+
+    private:
+        std::ofstream file;
+        int width = 0;
+        int height = 0;
+        int delayCentiseconds = 10;
+    };
+}
@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "Logger.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <chrono>
+#include <ctime>
+#include <mutex>
+
+LogLevel Logger::currentLogLevel = LogLevel::INFO;
+Logger::Sink Logger::sink;
+bool Logger::fileLogging = true;
+
+static std::mutex logMutex;
+
+// Logger Implementation
+void Logger::Log(LogLevel level, const std::string& category, const std::string& message) {
+    if (level < currentLogLevel) return;
+    
+    std::string prefix = GetLogPrefix(level);
+    std::string timestamp = GetTimestamp();
+    std::string fullMessage = "[" + timestamp + "] " + prefix + " [" + category + "] " + message;
+    
+    // The analytics worker logs too; keep lines and the log file whole
+    std::lock_guard<std::mutex> lock(logMutex);
+    if (sink) {
+        sink(fullMessage);
+    }
+    
+    if (fileLogging) {
+        WriteToLogFile(fullMessage);
+    }
+}
+
+std::string Logger::GetLogPrefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "[DEBUG]";
+        case LogLevel::INFO: return "[INFO]";
+        case LogLevel::WARNING: return "[WARNING]";
+        case LogLevel::ERROR: return "[ERROR]";
+        default: return "[UNKNOWN]";
+    }
+}
+
+std::string Logger::GetTimestamp() {
+    auto now = std::chrono::system_clock::now();
+    auto time_t = std::chrono::system_clock::to_time_t(now);
+    std::stringstream ss;
+    ss << std::put_time(std::localtime(&time_t), "%H:%M:%S");
+    return ss.str();
+}
+
+void Logger::WriteToLogFile(const std::string& message) {
+    try {
+        std::filesystem::create_directories("data");
+        std::ofstream logFile("data/boostmaster.log", std::ios::app);
+        if (logFile.is_open()) {
+            logFile << message << std::endl;
+        }
+    }
+    catch (...) {
+        // Fail silently to avoid infinite logging loops
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <functional>
+
+// Logging System
+enum class LogLevel {
+    DEBUG,
+    INFO,
+    WARNING,
+    ERROR
+};
+
+// Formatted, levelled logging to a sink (the BakkesMod console in game, stdout in
+// headless tools) and optionally to data/boostmaster.log. Log may be called from
+// any thread; configure the sink and level before starting other threads.
+class Logger {
+public:
+    using Sink = std::function<void(const std::string&)>;
+
+    static void Log(LogLevel level, const std::string& category, const std::string& message);
+    static void SetLogLevel(LogLevel level) { currentLogLevel = level; }
+    static void SetSink(Sink newSink) { sink = std::move(newSink); }
+    static void SetFileLogging(bool enabled) { fileLogging = enabled; }
+    
+private:
+    static LogLevel currentLogLevel;
+    static Sink sink;
+    static bool fileLogging;
+    static std::string GetLogPrefix(LogLevel level);
+    static std::string GetTimestamp();
+    static void WriteToLogFile(const std::string& message);
+};
@@ -0,0 +1,97 @@
+#include "pch.h"
+#include "PlotSeries.h"
+#include <algorithm>
+#include <cmath>
+
+size_t Downsample::Lttb(std::span<const float> y, size_t points, float* out) {
+    const size_t n = y.size();
+    if (points >= n) {
+        std::copy(y.begin(), y.end(), out);
+        return n;
+    }
+    if (points < 3) {
+        // Too few points for buckets: keep the ends
+        for (size_t i = 0; i < points; ++i) out[i] = y[i == 0 ? 0 : n - 1];
+        return points;
+    }
+
+    // The first and last points are fixed; the rest are split into points - 2 buckets
+    const double every = double(n - 2) / double(points - 2);
+    size_t written = 0;
+    size_t a = 0;
+    out[written++] = y[0];
+
+    for (size_t i = 0; i < points - 2; ++i) {
+        // Average of the next bucket, the third triangle vertex
+        size_t nextStart = size_t((i + 1) * every) + 1;
+        size_t nextEnd = std::min(size_t((i + 2) * every) + 1, n);
+        if (nextStart >= nextEnd) nextStart = nextEnd - 1;
+        double avgX = 0.0, avgY = 0.0;
+        for (size_t j = nextStart; j < nextEnd; ++j) {
+            avgX += double(j);
+            avgY += y[j];
+        }
+        avgX /= double(nextEnd - nextStart);
+        avgY /= double(nextEnd - nextStart);
+
+        // Point in this bucket forming the largest triangle with the last pick and that average
+        size_t start = size_t(i * every) + 1;
+        size_t end = size_t((i + 1) * every) + 1;
+        double ax = double(a), ay = y[a];
+        double bestArea = -1.0;
+        size_t best = start;
+        for (size_t j = start; j < end; ++j) {
+            double area = std::abs((ax - avgX) * (double(y[j]) - ay) - (ax - double(j)) * (avgY - ay));
+            if (area > bestArea) {
+                bestArea = area;
+                best = j;
+            }
+        }
+        out[written++] = y[best];
+        a = best;
+    }
+
+    out[written++] = y[n - 1];
+    return written;
+}
+
+size_t Downsample::MinMax(std::span<const float> y, size_t points, float* out) {
+    const size_t n = y.size();
+    const size_t buckets = points / 2;
+    if (points >= n || buckets == 0) {
+        size_t count = std::min(n, points);
+        std::copy_n(y.begin(), count, out);
+        return count;
+    }
+
+    size_t written = 0;
+    for (size_t b = 0; b < buckets; ++b) {
+        size_t start = b * n / buckets;
+        size_t end = (b + 1) * n / buckets;
+        auto [lo, hi] = std::minmax_element(y.begin() + start, y.begin() + end);
+        if (lo < hi) {
+            out[written++] = *lo;
+            out[written++] = *hi;
+        }
+        else {
+            out[written++] = *hi;
+            out[written++] = *lo;
+        }
+    }
+    return written;
+}
+
+std::span<const float> PlotSeries::Downsampled(size_t points, DownsampleMode mode) const {
+    if (values.size() <= points) return values;
+    if (cacheVersion != version || cachePoints != points || cacheMode != mode) {
+        cache.resize(points);
+        size_t count = mode == DownsampleMode::MinMax
+            ? Downsample::MinMax(values, points, cache.data())
+            : Downsample::Lttb(values, points, cache.data());
+        cache.resize(count);
+        cacheVersion = version;
+        cachePoints = points;
+        cacheMode = mode;
+    }
+    return cache;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+enum class DownsampleMode {
+    Lttb,   // Largest-Triangle-Three-Buckets: one representative point per bucket
+    MinMax, // the minimum and maximum of each bucket, in index order
+};
+
+namespace Downsample {
+    // Pick at most `points` values from y (x is the index) that keep its visual shape.
+    // First and last samples are always kept. Returns the number written to out.
+    size_t Lttb(std::span<const float> y, size_t points, float* out);
+    // Split y into points / 2 buckets and emit each bucket's min and max; keeps spikes
+    // that LTTB may average away
+    size_t MinMax(std::span<const float> y, size_t points, float* out);
+}
+
+// Append-only series for the HUD plots. The maximum is kept as values arrive, and
+// the downsampled view is cached and rebuilt only after an append or when the
+// requested width changes, so drawing costs O(pixels) however long the history is.
+class PlotSeries {
+public:
+    void Push(float value) {
+        if (values.empty() || value > maxValue) maxValue = value;
+        values.push_back(value);
+        ++version;
+    }
+    void Clear() {
+        values.clear();
+        maxValue = 0.0f;
+        ++version;
+    }
+
+    size_t Size() const { return values.size(); }
+    bool Empty() const { return values.empty(); }
+    float Max() const { return maxValue; }
+    std::span<const float> Values() const { return values; }
+
+    // At most `points` values shaped like the full series; the full series when it is short enough
+    std::span<const float> Downsampled(size_t points, DownsampleMode mode = DownsampleMode::Lttb) const;
+
+private:
+    std::vector<float> values;
+    float maxValue = 0.0f;
+    uint64_t version = 0;
+
+    mutable std::vector<float> cache;
+    mutable uint64_t cacheVersion = ~0ull;
+    mutable size_t cachePoints = 0;
+    mutable DownsampleMode cacheMode = DownsampleMode::Lttb;
+};
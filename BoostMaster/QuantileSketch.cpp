@@ -0,0 +1,70 @@
+#include "pch.h"
+#include "QuantileSketch.h"
+#include <algorithm>
+#include <cmath>
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, double minVal, double maxVal)
+    : alpha(relativeAccuracy), minValue(minVal), maxValue(maxVal) {
+    gamma = (1.0 + alpha) / (1.0 - alpha);
+    logGamma = std::log(gamma);
+    minKey = static_cast<int>(std::ceil(std::log(minValue) / logGamma));
+    int maxKey = static_cast<int>(std::ceil(std::log(maxValue) / logGamma));
+    buckets.assign(static_cast<size_t>(maxKey - minKey + 1), 0);
+}
+
+int QuantileSketch::BucketIndex(double value) const {
+    int key = static_cast<int>(std::ceil(std::log(value) / logGamma));
+    return std::clamp(key - minKey, 0, static_cast<int>(buckets.size()) - 1);
+}
+
+// Midpoint of the bucket in relative terms, which keeps the error within alpha
+double QuantileSketch::BucketValue(int bucket) const {
+    return 2.0 * std::pow(gamma, bucket + minKey) / (gamma + 1.0);
+}
+
+void QuantileSketch::Add(double value, uint64_t weight) {
+    if (weight == 0 || std::isnan(value)) return;
+    count += weight;
+    if (value < minValue) {
+        zeroCount += weight;
+        return;
+    }
+    buckets[BucketIndex(value)] += weight;
+}
+
+double QuantileSketch::Quantile(double q) const {
+    if (count == 0) return 0.0;
+    q = std::clamp(q, 0.0, 1.0);
+    uint64_t rank = static_cast<uint64_t>(q * (count - 1));
+
+    uint64_t seen = zeroCount;
+    if (rank < seen) return 0.0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (rank < seen) return BucketValue(static_cast<int>(i));
+    }
+    return BucketValue(static_cast<int>(buckets.size()) - 1);
+}
+
+bool QuantileSketch::Merge(const QuantileSketch& other) {
+    if (other.alpha != alpha || other.minValue != minValue || other.maxValue != maxValue) return false;
+    for (size_t i = 0; i < buckets.size(); ++i) buckets[i] += other.buckets[i];
+    zeroCount += other.zeroCount;
+    count += other.count;
+    return true;
+}
+
+void QuantileSketch::Reset() {
+    std::fill(buckets.begin(), buckets.end(), 0);
+    zeroCount = 0;
+    count = 0;
+}
+
+bool QuantileSketch::Restore(uint64_t zeroBucket, const std::vector<uint64_t>& counts) {
+    if (counts.size() != buckets.size()) return false;
+    buckets = counts;
+    zeroCount = zeroBucket;
+    count = zeroBucket;
+    for (uint64_t c : buckets) count += c;
+    return true;
+}
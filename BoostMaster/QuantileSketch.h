@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+// DDSketch-style quantile sketch. Values fall into logarithmic buckets whose width
+// is a fixed relative accuracy, so every quantile is reported within that relative
+// error. The bucket array is sized once from the value range, so memory does not
+// grow with the number of samples, and two sketches with the same parameters merge
+// by adding bucket counts.
+class QuantileSketch {
+public:
+    // Values below minValue (including 0) share one bucket reported as 0; values
+    // above maxValue are clamped into the top bucket
+    explicit QuantileSketch(double relativeAccuracy = 0.01, double minValue = 1.0, double maxValue = 1.0e4);
+
+    void Add(double value, uint64_t weight = 1);
+    // q in [0, 1]; 0 when empty
+    double Quantile(double q) const;
+    // Bucket-wise add; false (and no change) if the parameters differ
+    bool Merge(const QuantileSketch& other);
+    void Reset();
+
+    uint64_t Count() const { return count; }
+    bool Empty() const { return count == 0; }
+
+    // Raw state for persistence
+    double RelativeAccuracy() const { return alpha; }
+    double MinValue() const { return minValue; }
+    double MaxValue() const { return maxValue; }
+    uint64_t ZeroCount() const { return zeroCount; }
+    const std::vector<uint64_t>& Buckets() const { return buckets; }
+    // Replace counts with persisted ones; false if the bucket count does not match
+    bool Restore(uint64_t zeroBucket, const std::vector<uint64_t>& counts);
+
+private:
+    int BucketIndex(double value) const;
+    double BucketValue(int bucket) const;
+
+    double alpha;
+    double minValue;
+    double maxValue;
+    double gamma;
+    double logGamma;
+    int minKey;
+    uint64_t count = 0;
+    uint64_t zeroCount = 0;
+    std::vector<uint64_t> buckets;
+};
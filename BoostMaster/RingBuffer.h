@@ -0,0 +1,63 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstddef>
+
+// Fixed-capacity ring buffer with O(1) push. Every element is written twice (slot
+// i and i + capacity) so the live contents are always one contiguous span, oldest
+// first, which can be handed straight to plotting code. Storage is allocated once.
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity = 0) { SetCapacity(capacity); }
+
+    // Reallocates and clears
+    void SetCapacity(size_t capacity) {
+        cap = capacity;
+        storage.assign(cap * 2, T{});
+        Clear();
+    }
+
+    void Clear() {
+        head = 0;
+        count = 0;
+    }
+
+    // Append a value; when full the oldest value is dropped and returned through evicted
+    bool Push(const T& value, T* evicted = nullptr) {
+        if (cap == 0) return false;
+        bool overwrote = count == cap;
+        if (overwrote && evicted) *evicted = storage[head];
+        storage[head] = value;
+        storage[head + cap] = value;
+        head = head + 1 == cap ? 0 : head + 1;
+        if (!overwrote) ++count;
+        return overwrote;
+    }
+
+    size_t Size() const { return count; }
+    size_t Capacity() const { return cap; }
+    bool Empty() const { return count == 0; }
+    bool Full() const { return count == cap; }
+
+    // 0 = oldest
+    const T& operator[](size_t i) const { return storage[Start() + i]; }
+    const T& Front() const { return storage[Start()]; }
+    const T& Back() const { return storage[Start() + count - 1]; }
+
+    // All live values, oldest first
+    std::span<const T> View() const { return { storage.data() + Start(), count }; }
+    // The newest n values (or fewer), oldest first
+    std::span<const T> Last(size_t n) const {
+        if (n > count) n = count;
+        return { storage.data() + Start() + (count - n), n };
+    }
+
+private:
+    size_t Start() const { return head + cap - count; }
+
+    std::vector<T> storage;
+    size_t cap = 0;
+    size_t head = 0; // next write slot in [0, cap)
+    size_t count = 0;
+};
@@ -0,0 +1,181 @@
+#include "pch.h"
+#include "SessionAnalytics.h"
+#include "Logger.h"
+#include <cfloat>
+#include <cmath>
+
+void SessionAnalytics::Reset() {
+    metrics.Reset();
+    heatmap.ClearData();
+    lastFrame = TelemetryFrame{};
+    lastLowBoostNotif = -1e9f;
+    lastEfficiencyNotif = -1e9f;
+}
+
+const TelemetryFrame* SessionAnalytics::Sample(const IGameView& game) {
+    if (!game.IsInGame()) return nullptr;
+
+    CarSnapshot car;
+    if (!game.GetLocalCar(car)) return nullptr;
+
+    float currentTime = game.Now();
+    if (metrics.sessionStartTime == 0.0f) {
+        metrics.sessionStartTime = currentTime;
+    }
+
+    // Build this tick's frame
+    TelemetryFrame frame;
+    frame.time = currentTime;
+    frame.position = car.location;
+    frame.velocity = car.velocity;
+    frame.speed = frame.velocity.magnitude();
+    frame.boost = car.boost;
+
+    // Distance and boost spent since the previous frame
+    float distance = 0.0f;
+    if (!metrics.frames.Empty()) {
+        TelemetryFrame prev = metrics.frames.Back();
+        distance = (frame.position - prev.position).magnitude();
+        frame.boostUsed = std::max(0.0f, prev.boost - frame.boost);
+        metrics.totalDistance += distance;
+    }
+    if (car.onGround) frame.flags |= TELEMETRY_ON_GROUND;
+    if (car.supersonic) frame.flags |= TELEMETRY_SUPERSONIC;
+    if (frame.boostUsed > 0.0f) frame.flags |= TELEMETRY_BOOSTING;
+    metrics.frames.Push(frame);
+    metrics.archive.Append(frame);
+    metrics.recentDistance.Add(distance);
+
+    // Session and windowed speed aggregates
+    float speed = frame.speed;
+    metrics.speedStats.Add(speed);
+    metrics.recentSpeed.Add(speed);
+    metrics.averageSpeed = (float)metrics.speedStats.Mean();
+
+    // Distribution sketches
+    for (SessionSketches* sk : {&metrics.sketches, &metrics.unsavedSketches}) {
+        sk->speed.Add(speed);
+        sk->boost.Add(frame.boost);
+    }
+    metrics.minuteBoostUsed += frame.boostUsed;
+    if (metrics.minuteStartTime == 0.0f) {
+        metrics.minuteStartTime = currentTime;
+    }
+    else if (currentTime - metrics.minuteStartTime >= 60.0f) {
+        metrics.sketches.boostPerMinute.Add(metrics.minuteBoostUsed);
+        metrics.unsavedSketches.boostPerMinute.Add(metrics.minuteBoostUsed);
+        metrics.minuteBoostUsed = 0.0f;
+        metrics.minuteStartTime += 60.0f;
+    }
+
+    // Heatmaps read the new frame straight from the store
+    heatmap.Update(metrics.frames);
+
+    lastFrame = frame;
+    return &lastFrame;
+}
+
+void SessionAnalytics::AnalyzePlaystyle(float boostEfficiency) {
+    std::string playstyle = "Balanced";
+    if (boostEfficiency > 80.0f && metrics.averageSpeed > 1200.0f) {
+        playstyle = "Aggressive";
+    } else if (boostEfficiency < 40.0f && metrics.averageSpeed < 800.0f) {
+        playstyle = "Defensive";
+    } else if (metrics.averageSpeed > 1000.0f) {
+        playstyle = "Fast-Paced";
+    } else if (boostEfficiency > 60.0f) {
+        playstyle = "Efficient";
+    }
+
+    if (metrics.detectedPlaystyle != playstyle) {
+        metrics.detectedPlaystyle = playstyle;
+        Logger::Log(LogLevel::INFO, "Analytics", "Detected playstyle: " + playstyle);
+
+        Notify(Notification{
+            NotificationType::Custom,
+            "Playstyle detected: " + playstyle,
+            5.0f,
+            false,
+            LinearColor{0.0f, 1.0f, 1.0f, 1.0f}
+        });
+    }
+}
+
+void SessionAnalytics::CheckCoachingTriggers(const IGameView& game, float lowBoostThreshold, float boostEfficiency) {
+    if (!game.IsInGame()) return;
+
+    CarSnapshot car;
+    if (!game.GetLocalCar(car)) return;
+    float now = game.Now();
+
+    // Low boost coaching; both sides are percentages (see BoostPercent)
+    if (car.boost < lowBoostThreshold && padSoA) {
+        // One batched pass over the pad coordinates, skipping pads that are respawning
+        float minDistSq = FLT_MAX;
+        padSoA->Nearest(car.location, padTracker ? padTracker->DownMask(now) : 0, &minDistSq);
+        float minDistance = minDistSq == FLT_MAX ? FLT_MAX : std::sqrt(minDistSq);
+
+        if (minDistance < 1000.0f && minDistance > 0.0f && now - lastLowBoostNotif > 5.0f) { // Don't spam notifications
+            Notify(Notification{
+                NotificationType::LowBoost,
+                "Boost pad nearby - " + std::to_string((int)minDistance) + " units",
+                3.0f,
+                false,
+                LinearColor{1.0f, 1.0f, 0.0f, 1.0f}
+            });
+            lastLowBoostNotif = now;
+        }
+    }
+
+    // High efficiency praise
+    if (boostEfficiency > 85.0f && now - lastEfficiencyNotif > 30.0f) {
+        Notify(Notification{
+            NotificationType::HighEfficiency,
+            "Excellent boost efficiency: " + std::to_string((int)boostEfficiency) + "%!",
+            4.0f,
+            false,
+            LinearColor{0.0f, 1.0f, 0.0f, 1.0f}
+        });
+        lastEfficiencyNotif = now;
+    }
+}
+
+void SessionAnalytics::OnGoalScored() {
+    Logger::Log(LogLevel::INFO, "Events", "Goal scored!");
+
+    Notify(Notification{
+        NotificationType::GoalScored,
+        "GOAL! Great shot!",
+        3.0f,
+        true,
+        LinearColor{0.0f, 1.0f, 0.0f, 1.0f}
+    });
+}
+
+void SessionAnalytics::OnBallTouch() {
+    metrics.ballTouches++;
+
+    if (metrics.ballTouches % 50 == 0) {
+        Notify(Notification{
+            NotificationType::BallHit,
+            "Ball touches: " + std::to_string(metrics.ballTouches),
+            2.0f,
+            false,
+            LinearColor{1.0f, 1.0f, 0.0f, 1.0f}
+        });
+    }
+}
+
+void SessionAnalytics::OnDemolished() {
+    metrics.totalDemos++;
+    Logger::Log(LogLevel::INFO, "Events", "Car demolished! Total: " + std::to_string(metrics.totalDemos));
+}
+
+void SessionAnalytics::ApplyEvent(RecordedEventType type, float time, int32_t arg, BoostPadTracker& tracker) {
+    switch (type) {
+        case RecordedEventType::BallTouch: OnBallTouch(); break;
+        case RecordedEventType::Goal: OnGoalScored(); break;
+        case RecordedEventType::Demolished: OnDemolished(); break;
+        case RecordedEventType::BoostPickup: tracker.MarkTaken(arg, time); break;
+    }
+}
@@ -0,0 +1,196 @@
+#pragma once
+#include <string>
+#include <functional>
+#include <cmath>
+#include <algorithm>
+#include <span>
+#include "bakkesmod/wrappers/WrapperStructs.h"
+#include "RingBuffer.h"
+#include "StreamingStats.h"
+#include "QuantileSketch.h"
+#include "TelemetryFrameStore.h"
+#include "TelemetryCodec.h"
+#include "HeatmapGenerator.h"
+#include "BoostPadSoA.h"
+#include "BoostPadTracker.h"
+#include "SessionRecording.h"
+
+// The analytics half of the plugin: sampling, aggregates, heatmaps, playstyle and
+// coaching decisions. Nothing here touches BakkesMod objects; the car and clock
+// come through IGameView, so the same code runs live (BoostMaster) and headless
+// against recordings (SessionReplay).
+
+// Distribution sketches for speed (uu/s), boost level (%) and boost used per minute
+struct SessionSketches {
+    QuantileSketch speed{0.01, 1.0, 1.0e4};
+    QuantileSketch boost{0.01, 0.5, 100.0};
+    QuantileSketch boostPerMinute{0.01, 1.0, 1.0e4};
+    
+    void Merge(const SessionSketches& other) {
+        speed.Merge(other.speed);
+        boost.Merge(other.boost);
+        boostPerMinute.Merge(other.boostPerMinute);
+    }
+    
+    void Reset() {
+        speed.Reset();
+        boost.Reset();
+        boostPerMinute.Reset();
+    }
+};
+
+// Advanced Analytics System
+struct PerformanceMetrics {
+    float sessionStartTime = 0.0f;
+    float totalDistance = 0.0f;
+    float averageSpeed = 0.0f;
+    int totalDemos = 0;
+    int totalSaves = 0;
+    int ballTouches = 0;
+    // The most recent samples only: a ring of HISTORY_CAPACITY frames, five minutes at
+    // 120 Hz, older frames are overwritten. Heatmaps consume it incrementally and the
+    // recent-window queries below read it; anything covering the whole session must
+    // use the running aggregates, the sketches or the archive instead.
+    static constexpr size_t HISTORY_CAPACITY = 36000;
+    TelemetryFrameStore frames{HISTORY_CAPACITY};
+    // The full session at full rate, quantized and delta-coded (a few MB per hour)
+    CompressedTelemetry archive;
+    
+    // Incremental aggregates; constant cost per sample regardless of session length.
+    // The recent windows hold RECENT_WINDOW_SECONDS of samples at the current sample
+    // rate; SetSampleRate resizes them.
+    static constexpr float RECENT_WINDOW_SECONDS = 60.0f;
+    static constexpr float DEFAULT_SAMPLE_RATE = 120.0f;
+    RunningStats speedStats;
+    SlidingWindowStats recentSpeed{RecentWindowSamples(DEFAULT_SAMPLE_RATE)};
+    SlidingWindowStats recentDistance{RecentWindowSamples(DEFAULT_SAMPLE_RATE)};
+    
+    // Quantile sketches for this session, plus the part not yet merged into the
+    // long-term file by saveMatch
+    SessionSketches sketches;
+    SessionSketches unsavedSketches;
+    float minuteStartTime = 0.0f;
+    float minuteBoostUsed = 0.0f;
+    std::string detectedPlaystyle = "Balanced";
+    
+    static size_t RecentWindowSamples(float samplesPerSecond) {
+        return std::max<size_t>(1, static_cast<size_t>(std::lround(std::max(samplesPerSecond, 0.0f) * RECENT_WINDOW_SECONDS)));
+    }
+
+    // Resize the recent windows for a new sample rate; they restart empty if the size changes
+    void SetSampleRate(float samplesPerSecond) {
+        size_t samples = RecentWindowSamples(samplesPerSecond);
+        if (samples == recentSpeed.Capacity()) return;
+        recentSpeed.SetCapacity(samples);
+        recentDistance.SetCapacity(samples);
+    }
+
+    // Number of retained samples recorded at or after time (0 if the window is empty)
+    size_t SamplesSince(float time) const {
+        return frames.Size() - frames.IndexAtOrAfter(time);
+    }
+    
+    // Speeds over the last `seconds` before now, oldest first
+    std::span<const float> SpeedsInLast(float seconds, float now) const {
+        return frames.Speed().Last(SamplesSince(now - seconds));
+    }
+    
+    void Reset() {
+        sessionStartTime = 0.0f;
+        totalDistance = 0.0f;
+        averageSpeed = 0.0f;
+        totalDemos = 0;
+        totalSaves = 0;
+        ballTouches = 0;
+        frames.Clear();
+        archive.Clear();
+        speedStats.Reset();
+        recentSpeed.Reset();
+        recentDistance.Reset();
+        sketches.Reset();
+        unsavedSketches.Reset();
+        minuteStartTime = 0.0f;
+        minuteBoostUsed = 0.0f;
+        detectedPlaystyle = "Balanced";
+    }
+};
+
+// Notification System
+enum class NotificationType {
+    LowBoost,
+    HighEfficiency,
+    PositioningSuggestion,
+    BoostPadTiming,
+    GoalScored,
+    BallHit,
+    Custom
+};
+
+struct Notification {
+    NotificationType type;
+    std::string message;
+    float duration;
+    bool soundEnabled;
+    LinearColor color;
+    float timeShown = 0.0f;
+};
+
+// What analytics reads from the local car each sample
+struct CarSnapshot {
+    Vector location;
+    Vector velocity;
+    float boost = 0.0f; // 0-100
+    bool onGround = false;
+    bool supersonic = false;
+};
+
+// Stand-in for the GameWrapper/CarWrapper calls analytics makes
+class IGameView {
+public:
+    virtual ~IGameView() = default;
+    virtual bool IsInGame() const = 0;
+    // False when there is no local car
+    virtual bool GetLocalCar(CarSnapshot& out) const = 0;
+    virtual float Now() const = 0;
+};
+
+class SessionAnalytics {
+public:
+    using NotifySink = std::function<void(const Notification&)>;
+
+    PerformanceMetrics metrics;
+    HeatmapGenerator heatmap;
+
+    // Receives coaching, playstyle and milestone notifications
+    void SetNotifySink(NotifySink sink) { notify = std::move(sink); }
+    // Pads used for coaching; the tracker supplies which pads are respawning
+    void SetPads(const BoostPadSoA* soa, const BoostPadTracker* tracker) { padSoA = soa; padTracker = tracker; }
+    // Telemetry samples per second; sizes the time-based recent windows
+    void SetSampleRate(float samplesPerSecond) { metrics.SetSampleRate(samplesPerSecond); }
+    void Reset();
+
+    // Take one telemetry sample; returns the new frame, or nullptr if there was no car
+    const TelemetryFrame* Sample(const IGameView& game);
+    void AnalyzePlaystyle(float boostEfficiency);
+    // lowBoostThreshold is a percentage, compared with CarSnapshot::boost (0-100)
+    void CheckCoachingTriggers(const IGameView& game, float lowBoostThreshold, float boostEfficiency);
+
+    // Events
+    void OnGoalScored();
+    void OnBallTouch();
+    void OnDemolished();
+    // Dispatch a recorded or queued event; pickups mark the pad taken on tracker
+    void ApplyEvent(RecordedEventType type, float time, int32_t arg, BoostPadTracker& tracker);
+
+private:
+    void Notify(const Notification& notif) const {
+        if (notify) notify(notif);
+    }
+
+    NotifySink notify;
+    const BoostPadSoA* padSoA = nullptr;
+    const BoostPadTracker* padTracker = nullptr;
+    TelemetryFrame lastFrame;
+    float lastLowBoostNotif = -1e9f;
+    float lastEfficiencyNotif = -1e9f;
+};
@@ -0,0 +1,308 @@
+#include "pch.h"
+#include "SessionRecording.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// SessionRecorder
+
+bool SessionRecorder::Open(const std::string& filePath, const std::string& mapName, float tickRate) {
+    Close();
+    file.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    path = filePath;
+
+    RecordingHeader header{};
+    std::memcpy(header.magic, Bmrec::kMagic, sizeof(header.magic));
+    header.version = Bmrec::kVersion;
+    header.columnCount = kRecordingColumnCount;
+    header.tickRate = tickRate;
+    header.startUnixTime = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::strncpy(header.mapName, mapName.c_str(), sizeof(header.mapName) - 1);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (auto& column : columns) {
+        column.clear();
+        column.reserve(Bmrec::kFramesPerChunk);
+    }
+    pendingFrames = 0;
+    framesWritten = 0;
+    index.clear();
+    events.clear();
+    eventsWritten = 0;
+    return file.good();
+}
+
+void SessionRecorder::Append(const TelemetryFrame& frame) {
+    if (!file.is_open()) return;
+
+    uint32_t flagBits = frame.flags;
+    float flagsAsFloat;
+    std::memcpy(&flagsAsFloat, &flagBits, sizeof(flagsAsFloat));
+
+    const float values[kRecordingColumnCount] = {
+        frame.time,
+        frame.position.X, frame.position.Y, frame.position.Z,
+        frame.velocity.X, frame.velocity.Y, frame.velocity.Z,
+        frame.speed, frame.boost, frame.boostUsed,
+        flagsAsFloat,
+    };
+    for (uint32_t c = 0; c < kRecordingColumnCount; ++c) {
+        columns[c].push_back(values[c]);
+    }
+    if (++pendingFrames == Bmrec::kFramesPerChunk) WriteChunk();
+}
+
+void SessionRecorder::AddEvent(RecordedEventType type, float time, int32_t arg, uint32_t flags) {
+    if (!file.is_open()) return;
+    events.push_back({time, type, arg, flags});
+}
+
+void SessionRecorder::WriteChunk() {
+    if (pendingFrames == 0) return;
+
+    ChunkIndexEntry entry{};
+    entry.offset = static_cast<uint64_t>(file.tellp());
+    entry.firstFrame = framesWritten;
+    entry.firstTime = columns[0].front();
+    entry.lastTime = columns[0].back();
+    entry.frameCount = pendingFrames;
+    index.push_back(entry);
+
+    ChunkHeader header{Bmrec::kChunkMagic, pendingFrames, entry.firstTime, entry.lastTime};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (auto& column : columns) {
+        file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(float));
+        column.clear();
+    }
+    PadTo8();
+    WriteEventBlock();
+    file.flush();
+
+    framesWritten += pendingFrames;
+    pendingFrames = 0;
+}
+
+void SessionRecorder::WriteEventBlock() {
+    if (eventsWritten == events.size()) return;
+
+    const uint32_t count = static_cast<uint32_t>(events.size() - eventsWritten);
+    EventSectionHeader header{Bmrec::kEventBlockMagic, count};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(events.data() + eventsWritten), count * sizeof(RecordedEvent));
+    eventsWritten = events.size();
+}
+
+void SessionRecorder::PadTo8() {
+    static const char zeros[8] = {};
+    auto pos = static_cast<uint64_t>(file.tellp());
+    if (pos % 8) file.write(zeros, 8 - pos % 8);
+}
+
+void SessionRecorder::Close() {
+    if (!file.is_open()) return;
+    WriteChunk();
+    // Events after the last chunk, when no frames were pending
+    WriteEventBlock();
+
+    RecordingFooter footer{};
+    footer.eventsOffset = static_cast<uint64_t>(file.tellp());
+    EventSectionHeader eventHeader{Bmrec::kEventMagic, static_cast<uint32_t>(events.size())};
+    file.write(reinterpret_cast<const char*>(&eventHeader), sizeof(eventHeader));
+    file.write(reinterpret_cast<const char*>(events.data()), events.size() * sizeof(RecordedEvent));
+    PadTo8();
+
+    footer.indexOffset = static_cast<uint64_t>(file.tellp());
+    IndexSectionHeader indexHeader{Bmrec::kIndexMagic, static_cast<uint32_t>(index.size())};
+    file.write(reinterpret_cast<const char*>(&indexHeader), sizeof(indexHeader));
+    file.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(ChunkIndexEntry));
+
+    footer.frameCount = framesWritten;
+    footer.chunkCount = static_cast<uint32_t>(index.size());
+    footer.magic = Bmrec::kFooterMagic;
+    file.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    file.close();
+
+    index.clear();
+    events.clear();
+    eventsWritten = 0;
+}
+
+// SessionRecording
+
+bool SessionRecording::Open(const std::string& filePath) {
+    Close();
+
+#ifdef _WIN32
+    HANDLE fh = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fh == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(fh, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(RecordingHeader))) {
+        CloseHandle(fh);
+        return false;
+    }
+    HANDLE mh = CreateFileMappingA(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mh) {
+        CloseHandle(fh);
+        return false;
+    }
+    void* view = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mh);
+        CloseHandle(fh);
+        return false;
+    }
+    fileHandle = fh;
+    mappingHandle = mh;
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(RecordingHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+    data = static_cast<const uint8_t*>(view);
+    size = static_cast<size_t>(st.st_size);
+#endif
+
+    const RecordingHeader& header = Header();
+    if (std::memcmp(header.magic, Bmrec::kMagic, sizeof(header.magic)) != 0 ||
+        header.version == 0 || header.version > Bmrec::kVersion || header.columnCount != kRecordingColumnCount) {
+        Close();
+        return false;
+    }
+
+    complete = ReadFooter();
+    if (!complete) ScanChunks();
+    return true;
+}
+
+void SessionRecording::Close() {
+    if (data) {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(data), size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    complete = false;
+    frameCount = 0;
+    chunks.clear();
+    events = {};
+    recoveredEvents.clear();
+}
+
+bool SessionRecording::ReadFooter() {
+    if (size < sizeof(RecordingHeader) + sizeof(RecordingFooter)) return false;
+    const auto* footer = reinterpret_cast<const RecordingFooter*>(data + size - sizeof(RecordingFooter));
+    if (footer->magic != Bmrec::kFooterMagic) return false;
+    if (footer->eventsOffset + sizeof(EventSectionHeader) > size || footer->indexOffset + sizeof(IndexSectionHeader) > size) return false;
+
+    const auto* eventHeader = reinterpret_cast<const EventSectionHeader*>(data + footer->eventsOffset);
+    const auto* indexHeader = reinterpret_cast<const IndexSectionHeader*>(data + footer->indexOffset);
+    if (eventHeader->magic != Bmrec::kEventMagic || indexHeader->magic != Bmrec::kIndexMagic) return false;
+
+    uint64_t eventsEnd = footer->eventsOffset + sizeof(EventSectionHeader) + uint64_t(eventHeader->count) * sizeof(RecordedEvent);
+    uint64_t indexEnd = footer->indexOffset + sizeof(IndexSectionHeader) + uint64_t(indexHeader->count) * sizeof(ChunkIndexEntry);
+    if (eventsEnd > size || indexEnd > size) return false;
+
+    events = { reinterpret_cast<const RecordedEvent*>(eventHeader + 1), eventHeader->count };
+    const auto* entries = reinterpret_cast<const ChunkIndexEntry*>(indexHeader + 1);
+    chunks.assign(entries, entries + indexHeader->count);
+    for (const ChunkIndexEntry& entry : chunks) {
+        uint64_t chunkEnd = entry.offset + sizeof(ChunkHeader) + uint64_t(entry.frameCount) * kRecordingColumnCount * 4;
+        if (chunkEnd > size) {
+            chunks.clear();
+            events = {};
+            return false;
+        }
+    }
+    frameCount = footer->frameCount;
+    return true;
+}
+
+void SessionRecording::ScanChunks() {
+    chunks.clear();
+    events = {};
+    recoveredEvents.clear();
+    frameCount = 0;
+
+    // Both section headers start with their magic and are 8-byte aligned
+    uint64_t offset = sizeof(RecordingHeader);
+    while (offset + sizeof(EventSectionHeader) <= size) {
+        const uint32_t magic = *reinterpret_cast<const uint32_t*>(data + offset);
+        if (magic == Bmrec::kEventBlockMagic) {
+            const auto* header = reinterpret_cast<const EventSectionHeader*>(data + offset);
+            uint64_t bytes = sizeof(EventSectionHeader) + uint64_t(header->count) * sizeof(RecordedEvent);
+            if (offset + bytes > size) break;
+            const auto* first = reinterpret_cast<const RecordedEvent*>(header + 1);
+            recoveredEvents.insert(recoveredEvents.end(), first, first + header->count);
+            offset += bytes;
+            continue;
+        }
+
+        if (offset + sizeof(ChunkHeader) > size) break;
+        const auto* header = reinterpret_cast<const ChunkHeader*>(data + offset);
+        uint64_t bytes = sizeof(ChunkHeader) + uint64_t(header->frameCount) * kRecordingColumnCount * 4;
+        if (magic != Bmrec::kChunkMagic || header->frameCount == 0 || offset + bytes > size) break;
+
+        chunks.push_back({offset, frameCount, header->firstTime, header->lastTime, header->frameCount, 0});
+        frameCount += header->frameCount;
+        offset = (offset + bytes + 7) & ~uint64_t(7);
+    }
+    events = recoveredEvents;
+}
+
+RecordingChunk SessionRecording::Chunk(size_t i) const {
+    RecordingChunk chunk;
+    if (i >= chunks.size()) return chunk;
+
+    const ChunkIndexEntry& entry = chunks[i];
+    const auto* base = reinterpret_cast<const float*>(data + entry.offset + sizeof(ChunkHeader));
+    const size_t n = entry.frameCount;
+    auto column = [&](RecordingColumn c) {
+        return std::span<const float>(base + static_cast<size_t>(c) * n, n);
+    };
+
+    chunk.frameCount = entry.frameCount;
+    chunk.time = column(RecordingColumn::Time);
+    chunk.posX = column(RecordingColumn::PosX);
+    chunk.posY = column(RecordingColumn::PosY);
+    chunk.posZ = column(RecordingColumn::PosZ);
+    chunk.velX = column(RecordingColumn::VelX);
+    chunk.velY = column(RecordingColumn::VelY);
+    chunk.velZ = column(RecordingColumn::VelZ);
+    chunk.speed = column(RecordingColumn::Speed);
+    chunk.boost = column(RecordingColumn::Boost);
+    chunk.boostUsed = column(RecordingColumn::BoostUsed);
+    chunk.flags = { reinterpret_cast<const uint32_t*>(base + static_cast<size_t>(RecordingColumn::Flags) * n), n };
+    return chunk;
+}
+
+int SessionRecording::FindChunk(float t) const {
+    auto it = std::upper_bound(chunks.begin(), chunks.end(), t,
+        [](float time, const ChunkIndexEntry& entry) { return time < entry.firstTime; });
+    return static_cast<int>(it - chunks.begin()) - 1;
+}
@@ -0,0 +1,188 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <span>
+#include <fstream>
+#include <cstdint>
+#include "TelemetryFrameStore.h"
+
+// .bmrec session recordings. Little-endian, every section 8-byte aligned:
+//
+//   RecordingHeader
+//   (chunk event-block?)*
+//               chunk: ChunkHeader, then one raw column per TelemetryFrame field
+//               (kRecordingColumnCount columns of frameCount 4-byte values);
+//               event block: EventSectionHeader (kEventBlockMagic), then the
+//               RecordedEvents added since the previous chunk
+//   events      EventSectionHeader, RecordedEvent[count], every event again
+//   time index  IndexSectionHeader, ChunkIndexEntry[count]
+//   RecordingFooter
+//
+// Chunks and their event blocks are appended while playing; the combined events,
+// the index and the footer are written on Close(). A file without a footer
+// (crash, forced unload) is still readable, events included, by walking the
+// chunk and event block headers from the start. Version 1 files have no event
+// blocks, and events in files before version 3 carry no flags.
+namespace Bmrec {
+    constexpr uint32_t kVersion = 3;
+    constexpr char kMagic[8] = {'B', 'M', 'R', 'E', 'C', 0, 0, 0};
+    constexpr uint32_t kChunkMagic = 0x4B4E4843;  // "CHNK"
+    constexpr uint32_t kEventMagic = 0x53545645;  // "EVTS"
+    constexpr uint32_t kEventBlockMagic = 0x42545645; // "EVTB"
+    constexpr uint32_t kIndexMagic = 0x58444954;  // "TIDX"
+    constexpr uint32_t kFooterMagic = 0x54464D42; // "BMFT"
+    constexpr uint32_t kFramesPerChunk = 1024;
+    // RecordedEvent::flags
+    constexpr uint32_t kEventLocalCar = 1u << 0; // pickup or demolition of the recording player's car
+}
+
+// Column order within a chunk
+enum class RecordingColumn : uint32_t {
+    Time, PosX, PosY, PosZ, VelX, VelY, VelZ, Speed, Boost, BoostUsed, Flags,
+    Count
+};
+constexpr uint32_t kRecordingColumnCount = static_cast<uint32_t>(RecordingColumn::Count);
+
+enum class RecordedEventType : uint32_t {
+    BallTouch,
+    Goal,
+    Demolished,
+    BoostPickup,
+};
+
+struct RecordingHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t columnCount;
+    float tickRate;
+    uint32_t reserved;
+    int64_t startUnixTime;
+    char mapName[32];
+};
+
+struct ChunkHeader {
+    uint32_t magic;
+    uint32_t frameCount;
+    float firstTime;
+    float lastTime;
+};
+
+struct RecordedEvent {
+    float time;
+    RecordedEventType type;
+    int32_t arg;    // pad index for pickups, -1 otherwise
+    uint32_t flags; // Bmrec::kEvent* bits
+};
+
+struct EventSectionHeader {
+    uint32_t magic;
+    uint32_t count;
+};
+
+struct ChunkIndexEntry {
+    uint64_t offset;     // of the ChunkHeader
+    uint64_t firstFrame;
+    float firstTime;
+    float lastTime;
+    uint32_t frameCount;
+    uint32_t reserved;
+};
+
+struct IndexSectionHeader {
+    uint32_t magic;
+    uint32_t count;
+};
+
+struct RecordingFooter {
+    uint64_t eventsOffset;
+    uint64_t indexOffset;
+    uint64_t frameCount;
+    uint32_t chunkCount;
+    uint32_t magic;
+};
+
+static_assert(sizeof(RecordingHeader) == 64);
+static_assert(sizeof(ChunkHeader) == 16);
+static_assert(sizeof(RecordedEvent) == 16);
+static_assert(sizeof(ChunkIndexEntry) == 32);
+static_assert(sizeof(RecordingFooter) == 32);
+
+// Incremental writer used during play
+class SessionRecorder {
+public:
+    ~SessionRecorder() { Close(); }
+
+    bool Open(const std::string& path, const std::string& mapName, float tickRate);
+    void Append(const TelemetryFrame& frame);
+    void AddEvent(RecordedEventType type, float time, int32_t arg = -1, uint32_t flags = 0);
+    // Write the last partial chunk, events, index and footer
+    void Close();
+
+    bool IsOpen() const { return file.is_open(); }
+    const std::string& Path() const { return path; }
+    uint64_t FrameCount() const { return framesWritten + pendingFrames; }
+
+private:
+    void WriteChunk();
+    void WriteEventBlock();
+    void PadTo8();
+
+    std::ofstream file;
+    std::string path;
+    std::vector<float> columns[kRecordingColumnCount];
+    uint32_t pendingFrames = 0;
+    uint64_t framesWritten = 0;
+    std::vector<ChunkIndexEntry> index;
+    std::vector<RecordedEvent> events;
+    size_t eventsWritten = 0; // events already in an event block
+};
+
+// Zero-copy view of one chunk; spans point into the mapped file
+struct RecordingChunk {
+    uint32_t frameCount = 0;
+    std::span<const float> time, posX, posY, posZ, velX, velY, velZ, speed, boost, boostUsed;
+    std::span<const uint32_t> flags;
+};
+
+// Read-only memory-mapped recording
+class SessionRecording {
+public:
+    SessionRecording() = default;
+    ~SessionRecording() { Close(); }
+    SessionRecording(const SessionRecording&) = delete;
+    SessionRecording& operator=(const SessionRecording&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    // False if the footer was missing and chunks were recovered by scanning
+    bool Complete() const { return complete; }
+    const RecordingHeader& Header() const { return *reinterpret_cast<const RecordingHeader*>(data); }
+
+    uint64_t FrameCount() const { return frameCount; }
+    size_t ChunkCount() const { return chunks.size(); }
+    RecordingChunk Chunk(size_t i) const;
+    std::span<const ChunkIndexEntry> Index() const { return chunks; }
+    std::span<const RecordedEvent> Events() const { return events; }
+
+    // Chunk containing time t (the last chunk starting at or before t), or -1
+    int FindChunk(float t) const;
+
+private:
+    bool ReadFooter();
+    void ScanChunks();
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool complete = false;
+    uint64_t frameCount = 0;
+    std::vector<ChunkIndexEntry> chunks;
+    std::span<const RecordedEvent> events;
+    std::vector<RecordedEvent> recoveredEvents; // gathered from event blocks by ScanChunks
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
@@ -0,0 +1,100 @@
+#include "pch.h"
+#include "SessionReplay.h"
+#include "TelemetryScheduler.h"
+#include "BoostPadData.h"
+#include "BoostLedger.h"
+#include <chrono>
+#include <cfloat>
+#include <cstring>
+
+bool SessionReplay::Run(const std::string& path, SessionAnalytics& analytics,
+                        const ReplayOptions& options, ReplaySummary& summary) {
+    SessionRecording recording;
+    if (!recording.Open(path)) return false;
+    return Run(recording, analytics, options, summary);
+}
+
+bool SessionReplay::Run(const SessionRecording& recording, SessionAnalytics& analytics,
+                        const ReplayOptions& options, ReplaySummary& summary) {
+    if (!recording.IsOpen()) return false;
+    auto wallStart = std::chrono::steady_clock::now();
+    summary = ReplaySummary{};
+
+    // Pads for the recorded map, with availability rebuilt from pickup events
+    const RecordingHeader& header = recording.Header();
+    std::string mapName(header.mapName, strnlen(header.mapName, sizeof(header.mapName)));
+    const auto& pads = GetStaticBoostPadsForMap(mapName);
+    summary.pads = &pads;
+    BoostPadSoA padSoA;
+    padSoA.Build(pads);
+    BoostPadTracker padTracker;
+    padTracker.Sync(pads);
+    analytics.SetPads(&padSoA, &padTracker);
+    analytics.SetNotifySink([&summary](const Notification&) { summary.notifications++; });
+    if (header.tickRate > 0.0f) analytics.SetSampleRate(header.tickRate);
+
+    ReplayGameView game;
+    // Efficiency is rebuilt from the recorded boost levels and pickups, as live play does
+    BoostLedger ledger;
+    TelemetryScheduler scheduler;
+    scheduler.AddStage("coaching", options.coachingRate, [&](float) {
+        analytics.CheckCoachingTriggers(game, options.lowBoostThreshold, ledger.Session().Efficiency());
+    });
+    scheduler.AddStage("playstyle", options.playstyleRate, [&](float) {
+        analytics.AnalyzePlaystyle(ledger.Session().Efficiency());
+    });
+
+    // Pad availability follows every car's pickups, but the ledger only notes the
+    // local car's pickups and demolitions, as live play does. Files from before
+    // version 3 do not say whose event it was, so every event counts there.
+    auto events = recording.Events();
+    const bool eventsFlagged = header.version >= 3;
+    size_t nextEvent = 0;
+    auto applyEventsUpTo = [&](float time) {
+        for (; nextEvent < events.size() && events[nextEvent].time <= time; ++nextEvent) {
+            const RecordedEvent& ev = events[nextEvent];
+            analytics.ApplyEvent(ev.type, ev.time, ev.arg, padTracker);
+            const bool local = !eventsFlagged || (ev.flags & Bmrec::kEventLocalCar);
+            if (ev.type == RecordedEventType::BoostPickup && local && ev.arg >= 0 && ev.arg < (int)pads.size()) {
+                ledger.NotePickup(pads[ev.arg].type == PadType::Big ? BoostSource::BigPad : BoostSource::SmallPad, ev.time);
+            }
+            else if (ev.type == RecordedEventType::Goal || (ev.type == RecordedEventType::Demolished && local)) {
+                ledger.NoteRespawn(ev.time);
+            }
+        }
+    };
+
+    float firstTime = 0.0f, lastTime = 0.0f;
+    for (size_t c = 0; c < recording.ChunkCount(); ++c) {
+        RecordingChunk chunk = recording.Chunk(c);
+        for (uint32_t i = 0; i < chunk.frameCount; ++i) {
+            CarSnapshot car;
+            car.location = Vector(chunk.posX[i], chunk.posY[i], chunk.posZ[i]);
+            car.velocity = Vector(chunk.velX[i], chunk.velY[i], chunk.velZ[i]);
+            car.boost = chunk.boost[i];
+            car.onGround = (chunk.flags[i] & TELEMETRY_ON_GROUND) != 0;
+            car.supersonic = (chunk.flags[i] & TELEMETRY_SUPERSONIC) != 0;
+
+            float time = chunk.time[i];
+            game.SetFrame(car, time);
+            applyEventsUpTo(time);
+            analytics.Sample(game);
+            ledger.Tick(time, car.boost, car.supersonic);
+            scheduler.Advance(time);
+
+            if (summary.frames++ == 0) firstTime = time;
+            lastTime = time;
+        }
+    }
+    applyEventsUpTo(FLT_MAX);
+
+    analytics.SetPads(nullptr, nullptr);
+    analytics.SetNotifySink(nullptr);
+
+    summary.events = events.size();
+    summary.boostUsed = ledger.TotalUsed();
+    summary.boostEfficiency = ledger.Session().Efficiency();
+    summary.sessionSeconds = lastTime - firstTime;
+    summary.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    return true;
+}
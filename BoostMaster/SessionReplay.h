@@ -0,0 +1,58 @@
+#pragma once
+#include <string>
+#include <cstdint>
+#include "SessionAnalytics.h"
+#include "SessionRecording.h"
+
+struct ReplayOptions {
+    float coachingRate = 10.0f;
+    float playstyleRate = 1.0f;
+    float lowBoostThreshold = 20.0f;
+};
+
+struct ReplaySummary {
+    uint64_t frames = 0;
+    size_t events = 0;
+    size_t notifications = 0;
+    float sessionSeconds = 0.0f;
+    double wallSeconds = 0.0;
+    float boostUsed = 0.0f;
+    float boostEfficiency = 0.0f;
+    const std::vector<StaticBoostPad>* pads = nullptr; // layout of the recorded map
+
+    double Speedup() const { return wallSeconds > 0.0 ? sessionSeconds / wallSeconds : 0.0; }
+};
+
+// IGameView that serves one recorded frame at a time
+class ReplayGameView : public IGameView {
+public:
+    void SetFrame(const CarSnapshot& snapshot, float time) {
+        car = snapshot;
+        now = time;
+    }
+
+    bool IsInGame() const override { return true; }
+    bool GetLocalCar(CarSnapshot& out) const override {
+        out = car;
+        return true;
+    }
+    float Now() const override { return now; }
+
+private:
+    CarSnapshot car;
+    float now = 0.0f;
+};
+
+// Drives SessionAnalytics from a .bmrec recording as fast as the analytics allow.
+// Frames are fed to Sample() in order; recorded events are applied at their
+// timestamps; coaching and playstyle run from a TelemetryScheduler clocked by the
+// recorded time, so their cadence matches live play. The analytics object is not
+// reset, so several recordings can be folded into one session. Its notify sink and
+// pad context are replaced for the duration of the run.
+class SessionReplay {
+public:
+    static bool Run(const SessionRecording& recording, SessionAnalytics& analytics,
+                    const ReplayOptions& options, ReplaySummary& summary);
+    static bool Run(const std::string& path, SessionAnalytics& analytics,
+                    const ReplayOptions& options, ReplaySummary& summary);
+};
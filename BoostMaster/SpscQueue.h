@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Bounded single-producer/single-consumer ring. One thread may call TryPush and
+// one other thread TryPop; neither blocks or allocates. Head and tail live on
+// separate cache lines, and each side keeps a cached copy of the other's index so
+// the shared line is only re-read when the ring looks full (producer) or empty
+// (consumer). Capacity must be a power of two.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side; false when full
+    bool TryPush(const T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - headCache == Capacity) {
+            headCache = head.load(std::memory_order_acquire);
+            if (t - headCache == Capacity) return false;
+        }
+        slots[t & kMask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side; false when empty
+    bool TryPop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tailCache) {
+            tailCache = tail.load(std::memory_order_acquire);
+            if (h == tailCache) return false;
+        }
+        out = std::move(slots[h & kMask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when called while the other side is active
+    size_t Size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+    static constexpr size_t MaxSize() { return Capacity; }
+
+private:
+    static constexpr size_t kMask = Capacity - 1;
+
+    // Consumer-owned line
+    alignas(64) std::atomic<size_t> head{0};
+    size_t tailCache = 0;
+    // Producer-owned line
+    alignas(64) std::atomic<size_t> tail{0};
+    size_t headCache = 0;
+
+    alignas(64) T slots[Capacity] = {};
+};
@@ -0,0 +1,134 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "RingBuffer.h"
+
+// Session-wide running aggregates, updated in O(1) per sample: count, sum,
+// Welford mean/variance, min, max and an exponentially weighted moving average
+class RunningStats {
+public:
+    explicit RunningStats(double ewmaAlpha = 0.05) : alpha(ewmaAlpha) {}
+
+    void Add(double x) {
+        ++count;
+        sum += x;
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+        minValue = std::min(minValue, x);
+        maxValue = std::max(maxValue, x);
+        ewma = count == 1 ? x : ewma + alpha * (x - ewma);
+    }
+
+    void Reset() { *this = RunningStats(alpha); }
+
+    uint64_t Count() const { return count; }
+    double Sum() const { return sum; }
+    double Mean() const { return mean; }
+    double Variance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+    double StdDev() const { return std::sqrt(Variance()); }
+    double Min() const { return count ? minValue : 0.0; }
+    double Max() const { return count ? maxValue : 0.0; }
+    double Ewma() const { return ewma; }
+
+private:
+    double alpha;
+    uint64_t count = 0;
+    double sum = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    double minValue = std::numeric_limits<double>::max();
+    double maxValue = std::numeric_limits<double>::lowest();
+    double ewma = 0.0;
+};
+
+// Aggregates over the most recent `capacity` samples. Sum and sum of squares are
+// adjusted as samples enter and leave (and re-summed once per window to cancel
+// drift); min and max come from monotonic queues, so every update is amortised O(1).
+class SlidingWindowStats {
+public:
+    explicit SlidingWindowStats(size_t capacity = 0) { SetCapacity(capacity); }
+
+    void SetCapacity(size_t capacity) {
+        window.SetCapacity(capacity);
+        minQueue.assign(capacity, {});
+        maxQueue.assign(capacity, {});
+        Reset();
+    }
+
+    size_t Capacity() const { return window.Capacity(); }
+
+    void Reset() {
+        window.Clear();
+        sum = sumSq = 0.0;
+        pushed = 0;
+        minHead = minSize = maxHead = maxSize = 0;
+    }
+
+    void Add(float x) {
+        if (window.Capacity() == 0) return;
+        float evicted = 0.0f;
+        if (window.Push(x, &evicted)) {
+            sum -= evicted;
+            sumSq -= double(evicted) * evicted;
+        }
+        sum += x;
+        sumSq += double(x) * x;
+
+        uint64_t index = pushed++;
+        PushWedge(minQueue, minHead, minSize, index, x, [](float back, float v) { return back >= v; });
+        PushWedge(maxQueue, maxHead, maxSize, index, x, [](float back, float v) { return back <= v; });
+
+        if (pushed % window.Capacity() == 0) Resum();
+    }
+
+    size_t Count() const { return window.Size(); }
+    double Sum() const { return sum; }
+    double Mean() const { return window.Empty() ? 0.0 : sum / window.Size(); }
+    double Variance() const {
+        size_t n = window.Size();
+        if (n < 2) return 0.0;
+        double m = sum / n;
+        return std::max(0.0, (sumSq - n * m * m) / (n - 1));
+    }
+    double StdDev() const { return std::sqrt(Variance()); }
+    float Min() const { return minSize ? minQueue[minHead].value : 0.0f; }
+    float Max() const { return maxSize ? maxQueue[maxHead].value : 0.0f; }
+    const RingBuffer<float>& Samples() const { return window; }
+
+private:
+    struct Entry { uint64_t index = 0; float value = 0.0f; };
+
+    template <typename Dominated>
+    void PushWedge(std::vector<Entry>& q, size_t& head, size_t& size, uint64_t index, float x, Dominated dominated) {
+        const size_t cap = q.size();
+        // Drop the front once it falls out of the window
+        if (size && q[head].index + cap <= index) {
+            head = (head + 1) % cap;
+            --size;
+        }
+        // Drop values from the back that x makes irrelevant
+        while (size && dominated(q[(head + size - 1) % cap].value, x)) --size;
+        q[(head + size) % cap] = { index, x };
+        ++size;
+    }
+
+    void Resum() {
+        sum = sumSq = 0.0;
+        for (float v : window.View()) {
+            sum += v;
+            sumSq += double(v) * v;
+        }
+    }
+
+    RingBuffer<float> window;
+    double sum = 0.0;
+    double sumSq = 0.0;
+    uint64_t pushed = 0;
+    std::vector<Entry> minQueue, maxQueue;
+    size_t minHead = 0, minSize = 0;
+    size_t maxHead = 0, maxSize = 0;
+};
@@ -0,0 +1,281 @@
+#include "pch.h"
+#include "TelemetryCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    enum BlockMode : uint8_t {
+        MODE_VARINT = 0,
+        MODE_PACKED = 1,
+    };
+
+    int32_t Quantize(float value, float step) {
+        if (!std::isfinite(value)) return 0;
+        double q = std::round(static_cast<double>(value) / step);
+        q = std::clamp(q, static_cast<double>(std::numeric_limits<int32_t>::min()),
+                          static_cast<double>(std::numeric_limits<int32_t>::max()));
+        return static_cast<int32_t>(q);
+    }
+
+    int BitWidth(uint64_t v) {
+        int bits = 0;
+        while (v) { ++bits; v >>= 1; }
+        return bits;
+    }
+
+    size_t VarintSize(uint64_t v) {
+        size_t n = 1;
+        while (v >= 0x80) { v >>= 7; ++n; }
+        return n;
+    }
+}
+
+namespace TelemetryCodec {
+    void WriteVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    bool ReadVarint(const uint8_t*& p, const uint8_t* end, uint64_t& out) {
+        out = 0;
+        for (int shift = 0; shift < 64 && p < end; shift += 7) {
+            uint8_t byte = *p++;
+            out |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+}
+
+using namespace TelemetryCodec;
+
+// ColumnEncoder
+
+void ColumnEncoder::Append(float value) {
+    pending[pendingCount++] = Quantize(value, options.step);
+    if (pendingCount == kBlockSize) EncodeBlock();
+}
+
+void ColumnEncoder::Flush() {
+    if (pendingCount > 0) EncodeBlock();
+}
+
+void ColumnEncoder::Clear() {
+    bytes.clear();
+    blockOffsets.clear();
+    blockStarts.clear();
+    flushedCount = 0;
+    pendingCount = 0;
+    cachedBlock = SIZE_MAX;
+}
+
+void ColumnEncoder::EncodeBlock() {
+    const size_t n = pendingCount;
+    const int order = std::clamp(options.deltaOrder, 1, 2);
+
+    // Anchors restart the delta chain so the block decodes on its own
+    uint64_t anchors[2] = {};
+    size_t anchorCount = 0;
+    uint64_t residuals[kBlockSize];
+    size_t residualCount = 0;
+
+    int64_t prev = pending[0];
+    int64_t prevDelta = 0;
+    anchors[anchorCount++] = ZigZag(prev);
+    for (size_t i = 1; i < n; ++i) {
+        int64_t delta = static_cast<int64_t>(pending[i]) - prev;
+        if (order == 2 && i == 1) {
+            anchors[anchorCount++] = ZigZag(delta);
+        }
+        else {
+            residuals[residualCount++] = ZigZag(order == 2 ? delta - prevDelta : delta);
+        }
+        prevDelta = delta;
+        prev = pending[i];
+    }
+
+    // Pick whichever residual encoding is smaller for this block
+    uint64_t maxResidual = 0;
+    size_t varintBytes = 0;
+    for (size_t i = 0; i < residualCount; ++i) {
+        maxResidual = std::max(maxResidual, residuals[i]);
+        varintBytes += VarintSize(residuals[i]);
+    }
+    int width = BitWidth(maxResidual);
+    size_t packedBytes = (residualCount * width + 7) / 8;
+    BlockMode mode = options.bitPacking && packedBytes < varintBytes ? MODE_PACKED : MODE_VARINT;
+
+    blockOffsets.push_back(static_cast<uint32_t>(bytes.size()));
+    blockStarts.push_back(static_cast<uint32_t>(flushedCount));
+    WriteVarint(bytes, n);
+    bytes.push_back(mode);
+    bytes.push_back(static_cast<uint8_t>(width));
+    for (size_t i = 0; i < anchorCount; ++i) WriteVarint(bytes, anchors[i]);
+
+    if (mode == MODE_VARINT) {
+        for (size_t i = 0; i < residualCount; ++i) WriteVarint(bytes, residuals[i]);
+    }
+    else {
+        size_t base = bytes.size();
+        bytes.resize(base + packedBytes, 0);
+        size_t bit = 0;
+        for (size_t i = 0; i < residualCount; ++i) {
+            uint64_t v = residuals[i];
+            for (int b = 0; b < width; ++b, ++bit) {
+                if (v & (uint64_t(1) << b)) bytes[base + bit / 8] |= static_cast<uint8_t>(1u << (bit % 8));
+            }
+        }
+    }
+
+    flushedCount += n;
+    pendingCount = 0;
+}
+
+float ColumnEncoder::Get(size_t i) const {
+    if (i >= Count()) return std::numeric_limits<float>::quiet_NaN();
+    if (i >= flushedCount) return pending[i - flushedCount] * options.step;
+
+    size_t block = FindColumnBlock(blockStarts, i);
+    if (block != cachedBlock) {
+        const uint8_t* begin = bytes.data() + blockOffsets[block];
+        DecodeColumnBlock(begin, bytes.data() + bytes.size(), options, cache);
+        cachedBlock = block;
+    }
+    return cache[i - blockStarts[block]];
+}
+
+// Block decoding
+
+size_t FindColumnBlock(std::span<const uint32_t> blockStarts, size_t index) {
+    auto it = std::upper_bound(blockStarts.begin(), blockStarts.end(), index);
+    return it == blockStarts.begin() ? SIZE_MAX : static_cast<size_t>(it - blockStarts.begin()) - 1;
+}
+
+size_t DecodeColumnBlock(const uint8_t* p, const uint8_t* end, const ColumnCodecOptions& options, float* out) {
+    const int order = std::clamp(options.deltaOrder, 1, 2);
+    uint64_t n = 0;
+    if (!ReadVarint(p, end, n) || n == 0 || n > kBlockSize || end - p < 2) return 0;
+    uint8_t mode = *p++;
+    int width = *p++;
+    if (width > 64) return 0;
+
+    uint64_t anchor = 0;
+    if (!ReadVarint(p, end, anchor)) return 0;
+    int64_t value = UnZigZag(anchor);
+    int64_t delta = 0;
+    out[0] = value * options.step;
+    size_t i = 1;
+    if (order == 2 && n > 1) {
+        uint64_t first = 0;
+        if (!ReadVarint(p, end, first)) return 0;
+        delta = UnZigZag(first);
+        value += delta;
+        out[i++] = value * options.step;
+    }
+
+    size_t bit = 0;
+    for (; i < n; ++i) {
+        uint64_t zz = 0;
+        if (mode == MODE_VARINT) {
+            if (!ReadVarint(p, end, zz)) return 0;
+        }
+        else {
+            if (static_cast<size_t>(end - p) * 8 < bit + width) return 0;
+            for (int b = 0; b < width; ++b, ++bit) {
+                zz |= static_cast<uint64_t>((p[bit / 8] >> (bit % 8)) & 1) << b;
+            }
+        }
+        int64_t residual = UnZigZag(zz);
+        delta = order == 2 ? delta + residual : residual;
+        value += delta;
+        out[i] = value * options.step;
+    }
+    return static_cast<size_t>(n);
+}
+
+// ColumnDecoder
+
+size_t ColumnDecoder::DecodeBlock(size_t block, float* out) const {
+    if (block >= blockOffsets.size() || blockOffsets[block] >= bytes.size()) return 0;
+    return DecodeColumnBlock(bytes.data() + blockOffsets[block], bytes.data() + bytes.size(), options, out);
+}
+
+bool ColumnDecoder::Load(size_t block) {
+    if (block == cachedBlock) return cachedCount > 0;
+    cachedCount = DecodeBlock(block, cache);
+    cachedBlock = block;
+    return cachedCount > 0;
+}
+
+bool ColumnDecoder::Get(size_t index, float& out) {
+    if (blockStarts.size() != blockOffsets.size()) return false;
+    size_t block = FindColumnBlock(blockStarts, index);
+    if (block == SIZE_MAX || !Load(block)) return false;
+    size_t offset = index - blockStarts[block];
+    if (offset >= cachedCount) return false;
+    out = cache[offset];
+    return true;
+}
+
+bool ColumnDecoder::Next(float& out) {
+    if (!Get(cursor, out)) return false;
+    ++cursor;
+    return true;
+}
+
+// CompressedTelemetry
+
+CompressedTelemetry::CompressedTelemetry()
+    : time({0.0001f, 2, true}),
+      posX({1.0f, 1, true}), posY({1.0f, 1, true}), posZ({1.0f, 1, true}),
+      velX({1.0f, 1, true}), velY({1.0f, 1, true}), velZ({1.0f, 1, true}),
+      boost({0.01f, 1, true}),
+      flags({1.0f, 1, true}) {}
+
+void CompressedTelemetry::Append(const TelemetryFrame& frame) {
+    time.Append(frame.time);
+    posX.Append(frame.position.X);
+    posY.Append(frame.position.Y);
+    posZ.Append(frame.position.Z);
+    velX.Append(frame.velocity.X);
+    velY.Append(frame.velocity.Y);
+    velZ.Append(frame.velocity.Z);
+    boost.Append(frame.boost);
+    flags.Append(static_cast<float>(frame.flags));
+}
+
+void CompressedTelemetry::Flush() {
+    for (ColumnEncoder* column : {&time, &posX, &posY, &posZ, &velX, &velY, &velZ, &boost, &flags}) {
+        column->Flush();
+    }
+}
+
+void CompressedTelemetry::Clear() {
+    for (ColumnEncoder* column : {&time, &posX, &posY, &posZ, &velX, &velY, &velZ, &boost, &flags}) {
+        column->Clear();
+    }
+}
+
+size_t CompressedTelemetry::ByteSize() const {
+    size_t total = 0;
+    for (const ColumnEncoder* column : {&time, &posX, &posY, &posZ, &velX, &velY, &velZ, &boost, &flags}) {
+        total += column->ByteSize() + (column->BlockOffsets().size() + column->BlockStarts().size()) * sizeof(uint32_t);
+    }
+    return total;
+}
+
+TelemetryFrame CompressedTelemetry::Frame(size_t i) const {
+    TelemetryFrame frame;
+    frame.time = time.Get(i);
+    frame.position = Vector(posX.Get(i), posY.Get(i), posZ.Get(i));
+    frame.velocity = Vector(velX.Get(i), velY.Get(i), velZ.Get(i));
+    frame.speed = frame.velocity.magnitude();
+    frame.boost = boost.Get(i);
+    frame.boostUsed = i > 0 ? std::max(0.0f, boost.Get(i - 1) - frame.boost) : 0.0f;
+    frame.flags = static_cast<uint32_t>(flags.Get(i));
+    return frame;
+}
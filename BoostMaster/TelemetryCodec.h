@@ -0,0 +1,127 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include "TelemetryFrameStore.h"
+
+// Lossy-by-quantization column codec for telemetry. Values are quantized to
+// integers (value / step), delta-coded (first or second order), zigzag-mapped
+// and written per block of kBlockSize values as either LEB128 varints or a
+// fixed-width bit-packed run, whichever is smaller for that block. Blocks start
+// fresh from an anchor, so any block decodes independently of the others.
+//
+// Block layout: varint count, mode byte, bit width byte, zigzag varint anchors
+// (the first value, plus the first delta for second-order columns), residuals.
+namespace TelemetryCodec {
+    constexpr size_t kBlockSize = 256;
+
+    inline uint64_t ZigZag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+    inline int64_t UnZigZag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+    void WriteVarint(std::vector<uint8_t>& out, uint64_t value);
+    bool ReadVarint(const uint8_t*& p, const uint8_t* end, uint64_t& out);
+}
+
+struct ColumnCodecOptions {
+    float step = 1.0f;      // quantization step; values round to the nearest multiple
+    int deltaOrder = 1;     // 1 for positions/levels, 2 for near-constant-rate series like time
+    bool bitPacking = true; // allow the bit-packed block mode
+};
+
+// Block holding value index, given each block's first index in ascending order;
+// SIZE_MAX if index precedes the first block
+size_t FindColumnBlock(std::span<const uint32_t> blockStarts, size_t index);
+
+// Decode one block starting at p into out (room for kBlockSize values). Returns the
+// number of values, or 0 if the block is malformed.
+size_t DecodeColumnBlock(const uint8_t* p, const uint8_t* end, const ColumnCodecOptions& options, float* out);
+
+// Streaming column encoder. Values are buffered until a block fills, then encoded
+// and appended to Bytes(); BlockOffsets() indexes where each block starts and
+// BlockStarts() the index of its first value. Flush() may close a short block
+// mid-stream, so blocks are located through BlockStarts() rather than by dividing
+// by kBlockSize. Values still in the open block remain readable through Get().
+class ColumnEncoder {
+public:
+    explicit ColumnEncoder(ColumnCodecOptions options = {}) : options(options) {}
+
+    void Append(float value);
+    // Close the partial block, e.g. before persisting Bytes()
+    void Flush();
+    void Clear();
+
+    size_t Count() const { return flushedCount + pendingCount; }
+    size_t ByteSize() const { return bytes.size() + pendingCount * sizeof(int32_t); }
+    std::span<const uint8_t> Bytes() const { return bytes; }
+    std::span<const uint32_t> BlockOffsets() const { return blockOffsets; }
+    std::span<const uint32_t> BlockStarts() const { return blockStarts; }
+    const ColumnCodecOptions& Options() const { return options; }
+
+    // Random access; decodes (and caches) the block holding index i. NaN if i >= Count()
+    float Get(size_t i) const;
+
+private:
+    void EncodeBlock();
+
+    ColumnCodecOptions options;
+    std::vector<uint8_t> bytes;
+    std::vector<uint32_t> blockOffsets;
+    std::vector<uint32_t> blockStarts;
+    size_t flushedCount = 0;
+    int32_t pending[TelemetryCodec::kBlockSize] = {};
+    size_t pendingCount = 0;
+
+    mutable size_t cachedBlock = SIZE_MAX;
+    mutable float cache[TelemetryCodec::kBlockSize] = {};
+};
+
+// Reader over an encoded column held elsewhere (e.g. a mapped recording). Supports
+// block-level random access and sequential Next() with one block of scratch.
+class ColumnDecoder {
+public:
+    ColumnDecoder(std::span<const uint8_t> bytes, std::span<const uint32_t> blockOffsets,
+                  std::span<const uint32_t> blockStarts, ColumnCodecOptions options)
+        : bytes(bytes), blockOffsets(blockOffsets), blockStarts(blockStarts), options(options) {}
+
+    size_t BlockCount() const { return blockOffsets.size(); }
+    size_t DecodeBlock(size_t block, float* out) const;
+
+    bool Get(size_t index, float& out);
+    bool Next(float& out);
+    void Seek(size_t index) { cursor = index; }
+
+private:
+    bool Load(size_t block);
+
+    std::span<const uint8_t> bytes;
+    std::span<const uint32_t> blockOffsets;
+    std::span<const uint32_t> blockStarts;
+    ColumnCodecOptions options;
+    size_t cursor = 0;
+    size_t cachedBlock = SIZE_MAX;
+    size_t cachedCount = 0;
+    float cache[TelemetryCodec::kBlockSize] = {};
+};
+
+// Whole-session telemetry kept compressed, one encoder per TelemetryFrame field.
+// Speed and boost used are derived on decode, so they are not stored.
+class CompressedTelemetry {
+public:
+    CompressedTelemetry();
+
+    void Append(const TelemetryFrame& frame);
+    void Flush();
+    void Clear();
+
+    size_t Size() const { return time.Count(); }
+    size_t ByteSize() const;
+    TelemetryFrame Frame(size_t i) const;
+
+private:
+    ColumnEncoder time;
+    ColumnEncoder posX, posY, posZ;
+    ColumnEncoder velX, velY, velZ;
+    ColumnEncoder boost;
+    ColumnEncoder flags;
+};
@@ -0,0 +1,45 @@
+#include "pch.h"
+#include "TelemetryFrameStore.h"
+
+void TelemetryFrameStore::SetCapacity(size_t capacity) {
+    for (RingBuffer<float>* column : {&time, &posX, &posY, &posZ, &velX, &velY, &velZ, &speed, &boost, &boostUsed}) {
+        column->SetCapacity(capacity);
+    }
+    flags.SetCapacity(capacity);
+    sequence = 0;
+}
+
+void TelemetryFrameStore::Clear() {
+    for (RingBuffer<float>* column : {&time, &posX, &posY, &posZ, &velX, &velY, &velZ, &speed, &boost, &boostUsed}) {
+        column->Clear();
+    }
+    flags.Clear();
+    sequence = 0;
+}
+
+void TelemetryFrameStore::Push(const TelemetryFrame& frame) {
+    time.Push(frame.time);
+    posX.Push(frame.position.X);
+    posY.Push(frame.position.Y);
+    posZ.Push(frame.position.Z);
+    velX.Push(frame.velocity.X);
+    velY.Push(frame.velocity.Y);
+    velZ.Push(frame.velocity.Z);
+    speed.Push(frame.speed);
+    boost.Push(frame.boost);
+    boostUsed.Push(frame.boostUsed);
+    flags.Push(frame.flags);
+    ++sequence;
+}
+
+TelemetryFrame TelemetryFrameStore::Frame(size_t i) const {
+    TelemetryFrame frame;
+    frame.time = time[i];
+    frame.position = Vector(posX[i], posY[i], posZ[i]);
+    frame.velocity = Vector(velX[i], velY[i], velZ[i]);
+    frame.speed = speed[i];
+    frame.boost = boost[i];
+    frame.boostUsed = boostUsed[i];
+    frame.flags = flags[i];
+    return frame;
+}
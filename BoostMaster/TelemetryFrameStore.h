@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include "bakkesmod/wrappers/WrapperStructs.h"
+#include "RingBuffer.h"
+
+// Per-sample state bits stored in the flags column
+enum TelemetryFlag : uint32_t {
+    TELEMETRY_ON_GROUND = 1u << 0,
+    TELEMETRY_SUPERSONIC = 1u << 1,
+    TELEMETRY_BOOSTING = 1u << 2,
+};
+
+// One sample of the local car; the row view of TelemetryFrameStore
+struct TelemetryFrame {
+    float time = 0.0f;
+    Vector position;
+    Vector velocity;
+    float speed = 0.0f;
+    float boost = 0.0f;     // 0-100
+    float boostUsed = 0.0f; // boost spent since the previous frame, 0-100 scale
+    uint32_t flags = 0;
+};
+
+// The session's telemetry, stored column-wise: one ring buffer per field, all the
+// same length and indexed the same way (0 = oldest retained frame). Each column is
+// a single contiguous span, so scans over one field touch only that field's memory.
+// Sequence() counts every frame ever pushed, letting consumers that process frames
+// incrementally (heatmaps, downsample caches) tell what is new since their last look.
+class TelemetryFrameStore {
+public:
+    explicit TelemetryFrameStore(size_t capacity) { SetCapacity(capacity); }
+
+    void SetCapacity(size_t capacity);
+    void Clear();
+    void Push(const TelemetryFrame& frame);
+
+    size_t Size() const { return time.Size(); }
+    size_t Capacity() const { return time.Capacity(); }
+    bool Empty() const { return time.Empty(); }
+    uint64_t Sequence() const { return sequence; }
+
+    // Reassemble row i (0 = oldest)
+    TelemetryFrame Frame(size_t i) const;
+    TelemetryFrame Back() const { return Frame(Size() - 1); }
+
+    // Index of the first retained frame at or after t (Size() if none)
+    size_t IndexAtOrAfter(float t) const {
+        auto times = time.View();
+        return std::lower_bound(times.begin(), times.end(), t) - times.begin();
+    }
+    // Frames pushed after sequence number `seen`, clamped to what is still retained
+    size_t NewSince(uint64_t seen) const {
+        return static_cast<size_t>(std::min<uint64_t>(sequence - seen, Size()));
+    }
+
+    const RingBuffer<float>& Time() const { return time; }
+    const RingBuffer<float>& PosX() const { return posX; }
+    const RingBuffer<float>& PosY() const { return posY; }
+    const RingBuffer<float>& PosZ() const { return posZ; }
+    const RingBuffer<float>& VelX() const { return velX; }
+    const RingBuffer<float>& VelY() const { return velY; }
+    const RingBuffer<float>& VelZ() const { return velZ; }
+    const RingBuffer<float>& Speed() const { return speed; }
+    const RingBuffer<float>& Boost() const { return boost; }
+    const RingBuffer<float>& BoostUsed() const { return boostUsed; }
+    const RingBuffer<uint32_t>& Flags() const { return flags; }
+
+private:
+    RingBuffer<float> time;
+    RingBuffer<float> posX, posY, posZ;
+    RingBuffer<float> velX, velY, velZ;
+    RingBuffer<float> speed;
+    RingBuffer<float> boost;
+    RingBuffer<float> boostUsed;
+    RingBuffer<uint32_t> flags;
+    uint64_t sequence = 0;
+};
@@ -0,0 +1,96 @@
+#include "pch.h"
+#include "TelemetryScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+TelemetryScheduler::TelemetryScheduler(float tickRate)
+    : tickRate(tickRate), tickInterval(1.0 / tickRate) {}
+
+uint64_t TelemetryScheduler::PeriodTicks(float rateHz) const {
+    if (rateHz <= 0.0f) return 1;
+    return std::max<uint64_t>(1, static_cast<uint64_t>(std::lround(tickRate / rateHz)));
+}
+
+int TelemetryScheduler::AddStage(const std::string& name, float rateHz, StageFn fn, int maxCatchUp) {
+    uint64_t period = PeriodTicks(rateHz);
+    stages.push_back(Stage{name, rateHz, std::move(fn), std::max(1, maxCatchUp), period, tick + period, {}});
+    return static_cast<int>(stages.size()) - 1;
+}
+
+void TelemetryScheduler::SetStageRate(int stage, float rateHz) {
+    if (stage < 0 || stage >= static_cast<int>(stages.size())) return;
+    Stage& s = stages[stage];
+    s.rateHz = rateHz;
+    s.periodTicks = PeriodTicks(rateHz);
+    s.nextTick = std::min(s.nextTick, tick + s.periodTicks);
+}
+
+void TelemetryScheduler::SetTickRate(float hz) {
+    if (hz <= 0.0f || hz == tickRate) return;
+    tickRate = hz;
+    tickInterval = 1.0 / hz;
+    for (Stage& s : stages) {
+        s.periodTicks = PeriodTicks(s.rateHz);
+        s.nextTick = tick + s.periodTicks;
+    }
+    accumulator = 0.0;
+}
+
+void TelemetryScheduler::Reset() {
+    accumulator = 0.0;
+    lastTime = -1.0;
+    for (Stage& s : stages) {
+        s.nextTick = tick + s.periodTicks;
+    }
+}
+
+void TelemetryScheduler::ResetStats() {
+    droppedTicks = 0;
+    for (Stage& s : stages) {
+        s.stats = {};
+    }
+}
+
+int TelemetryScheduler::Advance(double now) {
+    if (lastTime < 0.0 || now < lastTime) {
+        lastTime = now;
+        return 0;
+    }
+    accumulator += now - lastTime;
+    lastTime = now;
+
+    // Small slack so a hook firing exactly once per tick never rounds down to zero
+    int ticks = static_cast<int>(accumulator / tickInterval + 1e-6);
+    if (ticks <= 0) return 0;
+    accumulator -= ticks * tickInterval;
+    if (ticks > kMaxCatchUpTicks) {
+        droppedTicks += ticks - kMaxCatchUpTicks;
+        ticks = kMaxCatchUpTicks;
+    }
+    tick += ticks;
+
+    for (Stage& s : stages) {
+        if (tick >= s.nextTick) RunDue(s);
+    }
+    return ticks;
+}
+
+void TelemetryScheduler::RunDue(Stage& stage) {
+    uint64_t due = (tick - stage.nextTick) / stage.periodTicks + 1;
+    uint64_t runs = std::min<uint64_t>(due, stage.maxCatchUp);
+    stage.stats.skipped += due - runs;
+    stage.nextTick += due * stage.periodTicks;
+
+    float dt = static_cast<float>(stage.periodTicks * tickInterval);
+    for (uint64_t i = 0; i < runs; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        stage.fn(dt);
+        float ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        stage.stats.runs++;
+        stage.stats.lastMs = ms;
+        stage.stats.maxMs = std::max(stage.stats.maxMs, ms);
+        if (ms > dt * 1000.0f) stage.stats.overruns++;
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <functional>
+
+// Fixed-step scheduler driven from a per-physics-tick hook. Advance(now) turns
+// elapsed time into whole ticks with an accumulator, so the tick count tracks the
+// clock regardless of how often the hook fires. Each stage runs at its own rate,
+// expressed as a whole number of ticks; when a stage falls several periods behind
+// it runs at most maxCatchUp times and the rest are counted as skipped. A stage
+// whose run takes longer than its period counts as an overrun.
+class TelemetryScheduler {
+public:
+    using StageFn = std::function<void(float dt)>;
+
+    static constexpr float kDefaultTickRate = 120.0f;
+    // Ticks owed beyond this after a hitch (pause, load) are dropped, not replayed
+    static constexpr int kMaxCatchUpTicks = 8;
+
+    struct StageStats {
+        uint64_t runs = 0;
+        uint64_t skipped = 0;
+        uint64_t overruns = 0;
+        float lastMs = 0.0f;
+        float maxMs = 0.0f;
+    };
+
+    explicit TelemetryScheduler(float tickRate = kDefaultTickRate);
+
+    // Returns a stage id for SetStageRate/GetStats
+    int AddStage(const std::string& name, float rateHz, StageFn fn, int maxCatchUp = 1);
+    void SetStageRate(int stage, float rateHz);
+    void SetTickRate(float hz);
+
+    // Run every stage that has come due by `now`; returns the number of ticks advanced
+    int Advance(double now);
+    // Forget the clock (e.g. after a map load) so the next Advance starts fresh
+    void Reset();
+
+    float TickRate() const { return tickRate; }
+    uint64_t TickCount() const { return tick; }
+    uint64_t DroppedTicks() const { return droppedTicks; }
+    size_t StageCount() const { return stages.size(); }
+    const std::string& StageName(int stage) const { return stages[stage].name; }
+    float StageRate(int stage) const { return stages[stage].rateHz; }
+    const StageStats& GetStats(int stage) const { return stages[stage].stats; }
+    void ResetStats();
+
+private:
+    struct Stage {
+        std::string name;
+        float rateHz;
+        StageFn fn;
+        int maxCatchUp;
+        uint64_t periodTicks;
+        uint64_t nextTick;
+        StageStats stats;
+    };
+
+    uint64_t PeriodTicks(float rateHz) const;
+    void RunDue(Stage& stage);
+
+    std::vector<Stage> stages;
+    float tickRate;
+    double tickInterval;
+    double accumulator = 0.0;
+    double lastTime = -1.0;
+    uint64_t tick = 0;
+    uint64_t droppedTicks = 0;
+};
@@ -0,0 +1,141 @@
+#include "pch.h"
+#include "TimeSeriesPyramid.h"
+#include <algorithm>
+
+// TimeSeriesPyramid
+
+void TimeSeriesPyramid::Append(float value) {
+    size_t i = raw.size();
+    raw.push_back(value);
+
+    size_t span = kLeafBlock;
+    for (auto& level : levels) {
+        size_t node = i / span;
+        if (node == level.size()) level.push_back({});
+        level.back().Add(value);
+        span *= kFanout;
+    }
+
+    // Start a new top level once the current top has more than one node
+    if (levels.empty() ? raw.size() > 1 : levels.back().size() > 1) {
+        BlockArray<PyramidNode, 1024> next;
+        if (levels.empty()) {
+            for (size_t j = 0; j < raw.size(); ++j) {
+                if (j % kLeafBlock == 0) next.push_back({});
+                next.back().Add(raw[j]);
+            }
+        }
+        else {
+            const auto& top = levels.back();
+            for (size_t j = 0; j < top.size(); ++j) {
+                if (j % kFanout == 0) next.push_back({});
+                next.back().Merge(top[j]);
+            }
+        }
+        levels.push_back(std::move(next));
+    }
+}
+
+void TimeSeriesPyramid::Clear() {
+    raw.clear();
+    levels.clear();
+}
+
+PyramidNode TimeSeriesPyramid::Range(size_t begin, size_t end) const {
+    PyramidNode acc;
+    end = std::min(end, raw.size());
+    if (begin >= end) return acc;
+
+    auto scanRaw = [&](size_t from, size_t to) {
+        for (size_t j = from; j < to; ++j) acc.Add(raw[j]);
+    };
+
+    // Whole leaf blocks inside the range; the ragged ends come from raw samples
+    size_t first = (begin + kLeafBlock - 1) / kLeafBlock;
+    size_t last = end / kLeafBlock;
+    if (levels.empty() || first >= last) {
+        scanRaw(begin, end);
+        return acc;
+    }
+    scanRaw(begin, first * kLeafBlock);
+    scanRaw(last * kLeafBlock, end);
+
+    // Climb while whole parent nodes fit, taking the unaligned nodes at each end
+    for (size_t k = 0; first < last; ++k) {
+        const auto& level = levels[k];
+        size_t parentFirst = (first + kFanout - 1) / kFanout;
+        size_t parentLast = last / kFanout;
+        if (k + 1 == levels.size() || parentFirst >= parentLast) {
+            for (size_t j = first; j < last; ++j) acc.Merge(level[j]);
+            break;
+        }
+        for (size_t j = first; j < parentFirst * kFanout; ++j) acc.Merge(level[j]);
+        for (size_t j = parentLast * kFanout; j < last; ++j) acc.Merge(level[j]);
+        first = parentFirst;
+        last = parentLast;
+    }
+    return acc;
+}
+
+void TimeSeriesPyramid::Query(size_t begin, size_t end, size_t buckets, float* outMin, float* outMax, float* outMean) const {
+    end = std::min(end, raw.size());
+    if (begin >= end || buckets == 0) return;
+
+    const size_t n = end - begin;
+    for (size_t p = 0; p < buckets; ++p) {
+        size_t a = begin + n * p / buckets;
+        size_t b = begin + n * (p + 1) / buckets;
+        if (b <= a) b = std::min(a + 1, end);
+        PyramidNode node = Range(a, b);
+        outMin[p] = node.min;
+        outMax[p] = node.max;
+        outMean[p] = node.Mean();
+    }
+}
+
+// SessionTimeline
+
+void SessionTimeline::Append(float time, float speed, float boost, float efficiency) {
+    std::lock_guard<std::mutex> lock(mutex);
+    times.push_back(time);
+    channels[static_cast<size_t>(TimelineChannel::Speed)].Append(speed);
+    channels[static_cast<size_t>(TimelineChannel::Boost)].Append(boost);
+    channels[static_cast<size_t>(TimelineChannel::Efficiency)].Append(efficiency);
+}
+
+void SessionTimeline::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    times.clear();
+    for (auto& channel : channels) channel.Clear();
+}
+
+bool SessionTimeline::TimeRange(float& first, float& last) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (times.empty()) return false;
+    first = times.front();
+    last = times.back();
+    return true;
+}
+
+size_t SessionTimeline::Query(TimelineChannel channel, float t0, float t1, size_t pixels,
+                              float* outMin, float* outMax, float* outMean) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Sample times are increasing, so the window maps to an index range by bisection
+    auto partition = [&](auto before) {
+        size_t lo = 0, hi = times.size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (before(times[mid])) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    };
+    size_t begin = partition([t0](float t) { return t < t0; });
+    size_t end = partition([t1](float t) { return t <= t1; });
+    if (begin >= end || pixels == 0) return 0;
+
+    // Fewer samples than pixels: one point per sample
+    size_t buckets = std::min(pixels, end - begin);
+    channels[static_cast<size_t>(channel)].Query(begin, end, buckets, outMin, outMax, outMean);
+    return buckets;
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+// Append-only array kept in fixed-size blocks. Growing allocates one new block and
+// never moves what is already stored, so an append under a lock stays short however
+// long the series gets.
+template <typename T, size_t BlockSize = 4096>
+class BlockArray {
+public:
+    void push_back(const T& value) {
+        if (count % BlockSize == 0) blocks.push_back(std::make_unique<T[]>(BlockSize));
+        blocks.back()[count++ % BlockSize] = value;
+    }
+    void clear() {
+        blocks.clear();
+        count = 0;
+    }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](size_t i) { return blocks[i / BlockSize][i % BlockSize]; }
+    const T& operator[](size_t i) const { return blocks[i / BlockSize][i % BlockSize]; }
+    T& back() { return (*this)[count - 1]; }
+    const T& front() const { return (*this)[0]; }
+    const T& back() const { return (*this)[count - 1]; }
+
+private:
+    std::vector<std::unique_ptr<T[]>> blocks;
+    size_t count = 0;
+};
+
+// Aggregate of a run of samples
+struct PyramidNode {
+    float min = 0.0f;
+    float max = 0.0f;
+    double sum = 0.0;
+    uint32_t count = 0;
+
+    void Add(float v) {
+        if (count == 0) {
+            min = max = v;
+        }
+        else {
+            if (v < min) min = v;
+            if (v > max) max = v;
+        }
+        sum += v;
+        ++count;
+    }
+    void Merge(const PyramidNode& other) {
+        if (other.count == 0) return;
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+        if (other.min < min) min = other.min;
+        if (other.max > max) max = other.max;
+        sum += other.sum;
+        count += other.count;
+    }
+    float Mean() const { return count ? float(sum / count) : 0.0f; }
+};
+
+// Min/max/mean mipmap over one channel. Raw samples are kept; level 0 summarizes
+// blocks of kLeafBlock samples and each level above summarizes kFanout nodes of the
+// one below. Append updates one node per level (O(log n)); a range aggregate reads
+// at most a partial leaf block at each end plus kFanout - 1 nodes per level at each
+// end (O(log n)), so a plot of p pixels costs O(p log n) at any zoom.
+class TimeSeriesPyramid {
+public:
+    static constexpr size_t kLeafBlock = 16;
+    static constexpr size_t kFanout = 4;
+
+    void Append(float value);
+    void Clear();
+    size_t Size() const { return raw.size(); }
+    float operator[](size_t i) const { return raw[i]; }
+
+    // Samples [begin, end)
+    PyramidNode Range(size_t begin, size_t end) const;
+    // Split [begin, end) into `buckets` equal slices and write each one's min, max and
+    // mean. Slices narrower than a sample reuse the sample under them.
+    void Query(size_t begin, size_t end, size_t buckets, float* outMin, float* outMax, float* outMean) const;
+
+private:
+    BlockArray<float> raw;
+    std::vector<BlockArray<PyramidNode, 1024>> levels;
+};
+
+enum class TimelineChannel {
+    Speed,
+    Boost,
+    Efficiency,
+    Count
+};
+
+// Timeline of the plotted channels since the last Clear(), appended by the
+// analytics worker and queried by the UI. Both sides take the internal lock; appends
+// hold it for one O(log n) update (storage grows in blocks, never by reallocating)
+// and queries for one O(pixels log n) pass. About 16 bytes per sample, so the
+// plugin clears it on each map load and on boostmaster_reset.
+class SessionTimeline {
+public:
+    void Append(float time, float speed, float boost, float efficiency);
+    void Clear();
+
+    // Time of the first and last sample; false while empty
+    bool TimeRange(float& first, float& last) const;
+    // Per-pixel min/max/mean of channel over [t0, t1]; returns the number of pixels
+    // written (0 if no samples fall in the window)
+    size_t Query(TimelineChannel channel, float t0, float t1, size_t pixels,
+                 float* outMin, float* outMax, float* outMean) const;
+
+private:
+    mutable std::mutex mutex;
+    BlockArray<float> times;
+    TimeSeriesPyramid channels[static_cast<size_t>(TimelineChannel::Count)];
+};
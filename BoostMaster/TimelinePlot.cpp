@@ -0,0 +1,75 @@
+#include "pch.h"
+#include "TimelinePlot.h"
+#include "imgui/imgui.h"
+#include "imgui/imguivariouscontrols.h"
+#include <algorithm>
+#include <cmath>
+
+static float GetPlotValue(const void* data, int idx) {
+    return static_cast<const float*>(data)[idx];
+}
+
+void TimelinePlot::Render(const SessionTimeline& timeline, const char* label) {
+    float first = 0.0f, last = 0.0f;
+    if (!timeline.TimeRange(first, last)) {
+        ImGui::Text("No telemetry yet");
+        return;
+    }
+
+    ImGui::PushID(label);
+    ImGui::RadioButton("Speed", &channel, static_cast<int>(TimelineChannel::Speed)); ImGui::SameLine();
+    ImGui::RadioButton("Boost", &channel, static_cast<int>(TimelineChannel::Boost)); ImGui::SameLine();
+    ImGui::RadioButton("Efficiency", &channel, static_cast<int>(TimelineChannel::Efficiency)); ImGui::SameLine();
+    ImGui::Checkbox("Follow", &follow);
+
+    // Keep the window inside the recorded range
+    const float duration = std::max(1.0f, last - first);
+    viewSpan = std::clamp(viewSpan, 1.0f, duration);
+    if (follow) viewEnd = last;
+    viewEnd = std::clamp(viewEnd, first + viewSpan, std::max(first + viewSpan, last));
+
+    const float width = std::max(1.0f, ImGui::GetContentRegionAvail().x);
+    const size_t pixels = static_cast<size_t>(width);
+    minValues.resize(pixels);
+    maxValues.resize(pixels);
+    meanValues.resize(pixels);
+    size_t count = timeline.Query(static_cast<TimelineChannel>(channel), viewEnd - viewSpan, viewEnd, pixels,
+                                  minValues.data(), maxValues.data(), meanValues.data());
+
+    float lo = 0.0f, hi = 1.0f;
+    if (count > 0) {
+        lo = *std::min_element(minValues.begin(), minValues.begin() + count);
+        hi = *std::max_element(maxValues.begin(), maxValues.begin() + count);
+        if (hi <= lo) hi = lo + 1.0f;
+    }
+
+    static const char* names[] = { "max", "mean", "min" };
+    static const ImColor colors[] = {
+        ImColor(1.0f, 0.5f, 0.0f, 1.0f),
+        ImColor(1.0f, 1.0f, 1.0f, 1.0f),
+        ImColor(0.0f, 0.5f, 1.0f, 1.0f),
+    };
+    const void* datas[] = { maxValues.data(), meanValues.data(), minValues.data() };
+    ImGui::PlotMultiLines("##timeline", 3, names, colors, GetPlotValue, datas, (int)count, lo, hi, ImVec2(width, 120));
+
+    if (ImGui::IsItemHovered()) {
+        ImGuiIO& io = ImGui::GetIO();
+        const float itemWidth = std::max(1.0f, ImGui::GetItemRectSize().x);
+        if (io.MouseWheel != 0.0f) {
+            // Zoom about the time under the cursor
+            float fraction = std::clamp((io.MousePos.x - ImGui::GetItemRectMin().x) / itemWidth, 0.0f, 1.0f);
+            float anchor = viewEnd - viewSpan * (1.0f - fraction);
+            float span = std::clamp(viewSpan * std::pow(0.8f, io.MouseWheel), 1.0f, duration);
+            viewEnd = anchor + span * (1.0f - fraction);
+            viewSpan = span;
+            follow = follow && viewEnd >= last;
+        }
+        if (ImGui::IsMouseDragging(0)) {
+            viewEnd -= io.MouseDelta.x / itemWidth * viewSpan;
+            follow = false;
+        }
+    }
+
+    ImGui::Text("%.1fs - %.1fs (%.1fs visible), range %.1f - %.1f", viewEnd - viewSpan - first, viewEnd - first, viewSpan, lo, hi);
+    ImGui::PopID();
+}
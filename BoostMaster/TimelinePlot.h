@@ -0,0 +1,21 @@
+#pragma once
+#include <vector>
+#include "TimeSeriesPyramid.h"
+
+// Zoom/pan view over a SessionTimeline. Draws min, mean and max per pixel with
+// PlotMultiLines, so the band shows spikes that a plain average would hide. Mouse
+// wheel zooms around the cursor, dragging pans, and "Follow" keeps the right edge
+// on the newest sample.
+class TimelinePlot {
+public:
+    void Render(const SessionTimeline& timeline, const char* label);
+
+private:
+    int channel = static_cast<int>(TimelineChannel::Speed);
+    float viewSpan = 60.0f; // seconds visible
+    float viewEnd = 0.0f;   // right edge, in timeline seconds
+    bool follow = true;
+    std::vector<float> minValues;
+    std::vector<float> maxValues;
+    std::vector<float> meanValues;
+};
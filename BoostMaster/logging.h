@@ -7,6 +7,8 @@
 #include <fstream>
 #include <iostream>
 #include <ctime>
+#include <chrono>
+#include <cstdint>
 
 #include "bakkesmod/wrappers/cvarmanagerwrapper.h"
 
@@ -120,3 +122,40 @@ void DEBUGLOG(const FormatWstring& fs, Args&&... args)
         }
     }
 }
+
+
+// Per-call-site state for hot-path logging (per-frame and per-tick code). Lives in a
+// function-local static created by the macros below; game thread only.
+struct HotLogSite
+{
+    std::chrono::steady_clock::time_point last{};
+    uint64_t lastKey = 0;
+    bool hasKey = false;
+
+    // True at most once per interval
+    bool Every(float seconds)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (last.time_since_epoch().count() != 0 && now - last < std::chrono::duration<float>(seconds)) return false;
+        last = now;
+        return true;
+    }
+
+    // True when key differs from the previous call
+    bool Changed(uint64_t key)
+    {
+        if (hasKey && key == lastKey) return false;
+        lastKey = key;
+        hasKey = true;
+        return true;
+    }
+};
+
+// Log at most once every `seconds` from this call site; arguments are only
+// formatted when the message is actually emitted
+#define LOG_THROTTLED(seconds, ...) \
+    do { static HotLogSite hotLogSite_; if (hotLogSite_.Every(seconds)) LOG(__VA_ARGS__); } while (0)
+
+// Log only when `key` differs from the last value seen at this call site
+#define LOG_ON_CHANGE(key, ...) \
+    do { static HotLogSite hotLogSite_; if (hotLogSite_.Changed(static_cast<uint64_t>(key))) LOG(__VA_ARGS__); } while (0)
@@ -1,5 +1,15 @@
 #pragma once
 
+#ifdef BOOSTMASTER_HEADLESS
+// Headless tools (tools/bmreplay) build the analytics sources without the plugin
+// runtime; they only need the SDK's plain structs
+#include <string>
+#include <vector>
+#include <functional>
+#include <memory>
+
+#include "bakkesmod/wrappers/WrapperStructs.h"
+#else
 #define WIN32_LEAN_AND_MEAN
 #define _CRT_SECURE_NO_WARNINGS
 #include "bakkesmod/plugin/bakkesmodplugin.h"
@@ -14,4 +24,5 @@
 #include "IMGUI/imgui_searchablecombo.h"
 #include "IMGUI/imgui_rangeslider.h"
 
-#include "logging.h"
\ No newline at end of file
+#include "logging.h"
+#endif
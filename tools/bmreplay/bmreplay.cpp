@@ -0,0 +1,144 @@
+// bmreplay: re-run BoostMaster analytics over .bmrec recordings outside the game.
+//
+// Builds from the plugin's analytics sources with BOOSTMASTER_HEADLESS defined and
+// the BakkesMod SDK include directory on the path (only its plain structs are used).
+// The command is one line, wrapped here:
+//
+//   g++ -std=c++20 -O2 -DBOOSTMASTER_HEADLESS -I<sdk>/include -IBoostMaster
+//       tools/bmreplay/bmreplay.cpp BoostMaster/SessionReplay.cpp BoostMaster/SessionAnalytics.cpp
+//       BoostMaster/SessionRecording.cpp BoostMaster/HeatmapGenerator.cpp BoostMaster/Logger.cpp
+//       BoostMaster/TelemetryScheduler.cpp BoostMaster/TelemetryFrameStore.cpp BoostMaster/TelemetryCodec.cpp
+//       BoostMaster/QuantileSketch.cpp BoostMaster/BoostPadSoA.cpp BoostMaster/BoostPadTracker.cpp
+//       BoostMaster/BoostPadSpatialIndex.cpp BoostMaster/BoostLedger.cpp BoostMaster/HeatmapDensity.cpp
+//       BoostMaster/HeatmapImage.cpp -o bmreplay
+//
+// Usage: bmreplay [--coaching-rate HZ] [--playstyle-rate HZ] [--low-boost PCT] [--verbose]
+//                 [--heatmap [--heatmap-cell UU] [--heatmap-bandwidth UU] [--heatmap-image png|ppm]
+//                            [--heatmap-timelapse STEP [--heatmap-window SECONDS]]]
+//                 <file.bmrec|dir>...
+//
+// --heatmap rebuilds each recording's heatmap from its raw samples: every sample is
+// binned into a fine grid, the grid is smoothed once with a separable Gaussian, and
+// the result is exported to data/heatmaps/<recording name>.csv. --heatmap-image also
+// renders the position layer with the recorded map's pads, and --heatmap-timelapse
+// writes <recording name>_timelapse.gif with a frame every STEP seconds of play,
+// covering up to HeatmapGenerator::MAX_RETAINED_MINUTES of the recording.
+
+#include "SessionReplay.h"
+#include "Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+    void CollectRecordings(const std::string& path, std::vector<std::string>& out) {
+        std::error_code ec;
+        if (std::filesystem::is_directory(path, ec)) {
+            std::vector<std::string> found;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec)) {
+                if (entry.path().extension() == ".bmrec") found.push_back(entry.path().string());
+            }
+            std::sort(found.begin(), found.end());
+            out.insert(out.end(), found.begin(), found.end());
+        }
+        else {
+            out.push_back(path);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    ReplayOptions options;
+    bool verbose = false;
+    bool heatmap = false;
+    float heatmapCell = 50.0f;
+    float heatmapBandwidth = 150.0f;
+    std::string heatmapImage;
+    HeatmapTimelapseOptions timelapse;
+    bool heatmapTimelapse = false;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--coaching-rate" && i + 1 < argc) options.coachingRate = std::strtof(argv[++i], nullptr);
+        else if (arg == "--playstyle-rate" && i + 1 < argc) options.playstyleRate = std::strtof(argv[++i], nullptr);
+        else if (arg == "--low-boost" && i + 1 < argc) options.lowBoostThreshold = std::strtof(argv[++i], nullptr);
+        else if (arg == "--verbose") verbose = true;
+        else if (arg == "--heatmap") heatmap = true;
+        else if (arg == "--heatmap-cell" && i + 1 < argc) heatmapCell = std::strtof(argv[++i], nullptr);
+        else if (arg == "--heatmap-bandwidth" && i + 1 < argc) heatmapBandwidth = std::strtof(argv[++i], nullptr);
+        else if (arg == "--heatmap-image" && i + 1 < argc) heatmapImage = argv[++i];
+        else if (arg == "--heatmap-timelapse" && i + 1 < argc) {
+            heatmapTimelapse = true;
+            timelapse.stepSeconds = std::strtof(argv[++i], nullptr);
+        }
+        else if (arg == "--heatmap-window" && i + 1 < argc) timelapse.windowSeconds = std::strtof(argv[++i], nullptr);
+        else CollectRecordings(arg, files);
+    }
+    if (files.empty()) {
+        std::fprintf(stderr, "usage: bmreplay [--coaching-rate HZ] [--playstyle-rate HZ] [--low-boost PCT] [--verbose]\n"
+                             "                [--heatmap [--heatmap-cell UU] [--heatmap-bandwidth UU] [--heatmap-image png|ppm]\n"
+                             "                           [--heatmap-timelapse STEP [--heatmap-window SECONDS]]]\n"
+                             "                <file.bmrec|dir>...\n");
+        return 2;
+    }
+
+    Logger::SetFileLogging(false);
+    Logger::SetLogLevel(verbose ? LogLevel::DEBUG : LogLevel::WARNING);
+    Logger::SetSink([](const std::string& message) { std::printf("%s\n", message.c_str()); });
+
+    uint64_t totalFrames = 0;
+    double totalSession = 0.0;
+    int failed = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (const std::string& file : files) {
+        SessionAnalytics analytics;
+        ReplaySummary summary;
+        // Plain bins while replaying; the kernel is applied once at the end
+        if (heatmap) analytics.heatmap.SetResolution(heatmapCell, true);
+        if (heatmapTimelapse) analytics.heatmap.SetRetainedMinutes(HeatmapGenerator::MAX_RETAINED_MINUTES);
+        if (!SessionReplay::Run(file, analytics, options, summary)) {
+            std::fprintf(stderr, "%s: not a readable recording\n", file.c_str());
+            failed++;
+            continue;
+        }
+        const PerformanceMetrics& m = analytics.metrics;
+        std::printf("%s: %llu frames, %.1fs session in %.1fms (%.0fx), avg speed %.0f, p90 speed %.0f, "
+                    "distance %.0f, touches %d, boost used %.0f (%.0f%% efficient), notifications %zu, playstyle %s\n",
+                    file.c_str(), static_cast<unsigned long long>(summary.frames), summary.sessionSeconds,
+                    summary.wallSeconds * 1000.0, summary.Speedup(), m.averageSpeed, m.sketches.speed.Quantile(0.9),
+                    m.totalDistance, m.ballTouches, summary.boostUsed, summary.boostEfficiency, summary.notifications,
+                    m.detectedPlaystyle.c_str());
+        if (heatmap) {
+            analytics.heatmap.BlurCumulative(heatmapBandwidth);
+            std::string name = std::filesystem::path(file).stem().string();
+            HeatmapImageOptions image;
+            image.pads = summary.pads;
+            if (heatmapTimelapse) {
+                // Frames are smoothed like the rebuilt grid
+                timelapse.bandwidth = heatmapBandwidth;
+                HeatmapImageOptions frames = image;
+                frames.width = 512;
+                analytics.heatmap.ExportTimelapse(name + "_timelapse", HeatmapLayer::Position, HeatmapGenerator::ALL_BANDS, timelapse, frames);
+            }
+            analytics.heatmap.ExportHeatmap(name);
+            if (!heatmapImage.empty()) {
+                analytics.heatmap.ExportImage(name, HeatmapLayer::Position, HeatmapView::Cumulative, HeatmapGenerator::ALL_BANDS,
+                                              image, heatmapImage == "ppm" ? HeatmapImageFormat::Ppm : HeatmapImageFormat::Png);
+            }
+        }
+        totalFrames += summary.frames;
+        totalSession += summary.sessionSeconds;
+    }
+
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%zu recordings, %llu frames, %.0fs of play in %.2fs (%.0f frames/s)\n",
+                files.size() - failed, static_cast<unsigned long long>(totalFrames), totalSession, wall,
+                wall > 0.0 ? totalFrames / wall : 0.0);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+// codeccheck: round-trip checks for the telemetry column codec.
+//
+// Builds headless like bmreplay and exits non-zero on the first mismatch:
+//
+//   g++ -std=c++20 -O2 -DBOOSTMASTER_HEADLESS -I<sdk>/include -IBoostMaster
+//       tools/codeccheck/codeccheck.cpp BoostMaster/TelemetryCodec.cpp -o codeccheck
+//
+// Each case appends a series in runs separated by Flush(), so short blocks land
+// mid-stream, then reads every value back through ColumnEncoder::Get (random and
+// sequential order) and through a ColumnDecoder over the encoded bytes. Reads past
+// the end must come back as NaN or false.
+
+#include "TelemetryCodec.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Case {
+        const char* name;
+        ColumnCodecOptions options;
+        std::vector<size_t> runs; // values appended between flushes
+    };
+
+    float Value(size_t i, const ColumnCodecOptions& options) {
+        // A steady ramp with some noise, quantized so the round trip is exact
+        float raw = options.deltaOrder == 2 ? i * (1.0f / 120.0f) : 1000.0f * std::sin(i * 0.05f) + (i * 7919 % 13);
+        return std::round(raw / options.step) * options.step;
+    }
+
+    bool Near(float a, float b, float step) {
+        return std::fabs(a - b) <= step * 0.5f + std::fabs(b) * 1e-6f;
+    }
+
+    bool Check(const Case& c) {
+        ColumnEncoder encoder(c.options);
+        std::vector<float> expected;
+        for (size_t run : c.runs) {
+            for (size_t k = 0; k < run; ++k) {
+                expected.push_back(Value(expected.size(), c.options));
+                encoder.Append(expected.back());
+            }
+            encoder.Flush();
+        }
+
+        if (encoder.Count() != expected.size()) {
+            std::printf("%s: count %zu, expected %zu\n", c.name, encoder.Count(), expected.size());
+            return false;
+        }
+
+        // Backwards first so every lookup lands outside the cached block
+        for (size_t i = expected.size(); i-- > 0;) {
+            float v = encoder.Get(i);
+            if (!Near(v, expected[i], c.options.step)) {
+                std::printf("%s: encoder value %zu is %f, expected %f\n", c.name, i, v, expected[i]);
+                return false;
+            }
+        }
+
+        if (!std::isnan(encoder.Get(expected.size())) || !std::isnan(encoder.Get(SIZE_MAX))) {
+            std::printf("%s: encoder read past the last value\n", c.name);
+            return false;
+        }
+
+        ColumnDecoder decoder(encoder.Bytes(), encoder.BlockOffsets(), encoder.BlockStarts(), c.options);
+        float v = 0.0f;
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (!decoder.Next(v) || !Near(v, expected[i], c.options.step)) {
+                std::printf("%s: decoder value %zu is %f, expected %f\n", c.name, i, v, expected[i]);
+                return false;
+            }
+        }
+        if (decoder.Next(v)) {
+            std::printf("%s: decoder read past the last value\n", c.name);
+            return false;
+        }
+        for (size_t i : { expected.size() - 1, size_t(0), expected.size() / 2 }) {
+            if (!decoder.Get(i, v) || !Near(v, expected[i], c.options.step)) {
+                std::printf("%s: decoder Get(%zu) is %f, expected %f\n", c.name, i, v, expected[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main() {
+    const ColumnCodecOptions position{ 1.0f, 1, true };
+    const ColumnCodecOptions time{ 0.0001f, 2, true };
+    const ColumnCodecOptions varintOnly{ 0.01f, 1, false };
+
+    const std::vector<Case> cases = {
+        { "whole blocks", position, { 1024 } },
+        { "flush after 100", position, { 100, 500 } },
+        { "flush after 100, time", time, { 100, 500 } },
+        { "many short flushes", varintOnly, { 1, 3, 255, 256, 257, 17, 600, 2 } },
+        { "block-aligned flushes", position, { 256, 256, 10, 256 } },
+    };
+
+    int failed = 0;
+    for (const Case& c : cases) {
+        bool ok = Check(c);
+        std::printf("%-24s %s\n", c.name, ok ? "ok" : "FAILED");
+        failed += ok ? 0 : 1;
+    }
+    return failed == 0 ? 0 : 1;
+}
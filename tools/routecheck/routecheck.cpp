@@ -0,0 +1,134 @@
+// routecheck: compares BoostPadRouter::FindBestRoute with exhaustive search.
+//
+// Builds headless like bmreplay and exits non-zero on the first mismatch:
+//
+//   g++ -std=c++20 -O2 -DBOOSTMASTER_HEADLESS -I<sdk>/include -IBoostMaster
+//       tools/routecheck/routecheck.cpp BoostMaster/BoostPadRouter.cpp -o routecheck
+//
+// Small random layouts with a budget large enough for the whole tree must return
+// the exhaustive optimum. On a fully connected 34-pad layout with the default
+// budget, every one- and two-stop route must still be scored, so the result is at
+// least as good as the best of those.
+
+#include "BoostPadRouter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+    // Must match BoostPadRouter.cpp
+    constexpr float kMinCruiseSpeed = 1000.0f;
+    constexpr float kMaxSpeed = 2300.0f;
+    constexpr float kTimeBias = 0.25f;
+
+    float Score(float gained, float time) { return gained / (time + kTimeBias); }
+
+    struct Layout {
+        std::vector<StaticBoostPad> pads;
+        std::vector<PadNode> graph;
+        std::vector<float> respawnAt;
+    };
+
+    Layout MakeLayout(std::mt19937& rng, int n) {
+        Layout layout;
+        std::uniform_real_distribution<float> x(-4000.0f, 4000.0f), y(-5000.0f, 5000.0f), respawn(-5.0f, 8.0f);
+        for (int i = 0; i < n; ++i) {
+            StaticBoostPad pad;
+            pad.location = Vector(x(rng), y(rng), 70.0f);
+            pad.type = rng() % 4 == 0 ? PadType::Big : PadType::Small;
+            pad.amount = pad.type == PadType::Big ? 100.0f : 12.0f;
+            layout.pads.push_back(pad);
+            layout.respawnAt.push_back(respawn(rng));
+        }
+        for (int i = 0; i < n; ++i) {
+            PadNode node;
+            node.index = i;
+            node.pad = &layout.pads[i];
+            for (int j = 0; j < n; ++j) {
+                if (j != i) node.neighbors.push_back(j);
+            }
+            layout.graph.push_back(node);
+        }
+        return layout;
+    }
+
+    float Dist(const Vector& a, const Vector& b) {
+        float dx = a.X - b.X, dy = a.Y - b.Y, dz = a.Z - b.Z;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Best score over every route of at most maxStops pads
+    float Exhaustive(const Layout& layout, const BoostRouteQuery& query, int maxStops) {
+        const float speed = std::clamp(query.carSpeed, kMinCruiseSpeed, kMaxSpeed);
+        float best = 0.0f;
+        auto visit = [&](auto&& self, int pad, int depth, uint64_t visited, float time, float boost, float gained) -> void {
+            best = std::max(best, Score(gained, time));
+            if (depth + 1 >= maxStops || boost >= 100.0f) return;
+            for (int next = 0; next < (int)layout.pads.size(); ++next) {
+                if (visited & (uint64_t(1) << next)) continue;
+                float t = time + Dist(layout.pads[pad].location, layout.pads[next].location) / speed;
+                if (layout.respawnAt[next] > query.now + t) continue;
+                float gain = std::min(layout.pads[next].amount, 100.0f - boost);
+                self(self, next, depth + 1, visited | (uint64_t(1) << next), t, boost + gain, gained + gain);
+            }
+        };
+        for (int pad = 0; pad < (int)layout.pads.size(); ++pad) {
+            float t = Dist(query.carLocation, layout.pads[pad].location) / speed;
+            if (layout.respawnAt[pad] > query.now + t) continue;
+            float gain = std::min(layout.pads[pad].amount, 100.0f - query.carBoost);
+            visit(visit, pad, 0, uint64_t(1) << pad, t, query.carBoost + gain, gain);
+        }
+        return best;
+    }
+
+    BoostRouteQuery MakeQuery(std::mt19937& rng, const Layout& layout) {
+        BoostRouteQuery query;
+        query.carLocation = Vector(std::uniform_real_distribution<float>(-4000.0f, 4000.0f)(rng),
+                                   std::uniform_real_distribution<float>(-5000.0f, 5000.0f)(rng), 17.0f);
+        query.carSpeed = std::uniform_real_distribution<float>(0.0f, 2300.0f)(rng);
+        query.carBoost = (float)(rng() % 90);
+        query.padRespawnAt = layout.respawnAt.data();
+        query.firstHopCandidates = (int)layout.pads.size();
+        return query;
+    }
+
+    bool Near(float a, float b) { return std::fabs(a - b) <= 1e-4f * std::max(1.0f, std::fabs(b)); }
+}
+
+int main() {
+    std::mt19937 rng(7);
+    int failed = 0;
+
+    // Whole tree within budget: must match exhaustive search exactly
+    for (int trial = 0; trial < 300; ++trial) {
+        Layout layout = MakeLayout(rng, 5 + trial % 5);
+        BoostRouteQuery query = MakeQuery(rng, layout);
+        query.maxStops = 1 + trial % 4;
+        query.expansionBudget = 1 << 20;
+        BoostRoute route = BoostPadRouter::FindBestRoute(layout.graph, query);
+        float got = Score(route.boostGained, route.travelTime);
+        float want = Exhaustive(layout, query, query.maxStops);
+        if (!Near(got, want)) {
+            std::printf("small layout %d: score %f, exhaustive %f\n", trial, got, want);
+            ++failed;
+        }
+    }
+
+    // Default budget on a full-size layout: one- and two-stop routes all scored
+    for (int trial = 0; trial < 50; ++trial) {
+        Layout layout = MakeLayout(rng, 34);
+        BoostRouteQuery query = MakeQuery(rng, layout);
+        BoostRoute route = BoostPadRouter::FindBestRoute(layout.graph, query);
+        float got = route.Empty() ? 0.0f : Score(route.boostGained, route.travelTime);
+        float floor = Exhaustive(layout, query, 2);
+        if (got < floor && !Near(got, floor)) {
+            std::printf("34-pad layout %d: score %f below the best two-stop route %f\n", trial, got, floor);
+            ++failed;
+        }
+    }
+
+    std::printf("%s\n", failed == 0 ? "ok" : "FAILED");
+    return failed == 0 ? 0 : 1;
+}